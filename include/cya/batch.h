@@ -0,0 +1,71 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo batch.h: Procesamiento por lotes de varios ficheros de puntos
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cya/binary_format.h"
+
+namespace cya {
+
+struct BatchOptions {
+  size_t jobs = 1;                 // Files processed at the same time
+  size_t memory_budget = 1 << 30;  // Estimated bytes in use by all the jobs
+  bool improved = false;           // Use QuickHullImproved
+  PointFormat format = TEXT;       // Format of the output hulls
+};
+
+struct BatchSummary {
+  size_t files = 0;
+  size_t failed = 0;
+  size_t points = 0;
+  double seconds = 0.0;
+};
+
+/**
+ * @brief Input files of a batch: the files matched by `source` if it is a
+ * glob pattern, or the ones listed in it, one per line, if it is a manifest.
+ *
+ * Blank manifest lines and lines starting with '#' are skipped.
+ */
+std::vector<std::string> ExpandInputs(const std::string& source);
+
+/**
+ * @brief Output file of every input inside `output_dir`, named after the
+ * input without its extensions. Inputs with the same name get a numbered
+ * suffix so no output is overwritten.
+ */
+std::vector<std::string> BatchOutputNames(const std::vector<std::string>& inputs,
+                                          const std::string& output_dir,
+                                          PointFormat format);
+
+/**
+ * @brief Computes the hull of every input on a pool of `options.jobs` threads
+ * and writes it to the matching output.
+ *
+ * A job only starts once its estimated memory fits in the budget. A file that
+ * fails is reported on `errors` and does not stop the others.
+ */
+BatchSummary RunBatch(const std::vector<std::string>& inputs,
+                      const std::vector<std::string>& outputs,
+                      const BatchOptions& options,
+                      std::ostream& errors);
+
+}  // namespace cya
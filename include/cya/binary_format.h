@@ -0,0 +1,156 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo binary_format.h: Formato binario de ficheros de puntos
+ * Referencias:
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+class BufferedWriter;
+
+/**
+ * Binary point files start with a 16 byte header followed by the raw
+ * coordinates, all little-endian:
+ *
+ *   offset 0   magic "CYAP"
+ *   offset 4   uint16 version
+ *   offset 6   uint8 coordinate type (CoordinateType)
+ *   offset 7   uint8 layout (Layout)
+ *   offset 8   uint64 amount of points
+ *
+ * With the AoS layout the coordinates are interleaved as x0 y0 x1 y1 ...; with
+ * the SoA layout all x coordinates come first and then all y coordinates.
+ */
+enum CoordinateType : std::uint8_t { FLOAT64 = 0, FLOAT32 = 1, INT32 = 2 };
+enum Layout : std::uint8_t { AOS = 0, SOA = 1 };
+enum PointFormat { TEXT, BINARY };
+
+constexpr char kBinaryMagic[4] = {'C', 'Y', 'A', 'P'};
+constexpr std::uint16_t kBinaryVersion = 1;
+constexpr size_t kBinaryHeaderSize = 16;
+
+struct BinaryHeader {
+  std::uint16_t version = kBinaryVersion;
+  CoordinateType coordinate_type = FLOAT64;
+  Layout layout = AOS;
+  std::uint64_t count = 0;
+};
+
+// Converts between host order and little-endian, in either direction
+template <typename T>
+inline T LittleEndian(T value) {
+  if constexpr (std::endian::native == std::endian::big) {
+    return std::byteswap(value);
+  }
+  return value;
+}
+
+inline size_t CoordinateSize(CoordinateType type) { return type == FLOAT64 ? 8 : 4; }
+
+// Binary coordinate type with the same memory layout as T, or -1 if none
+template <typename T>
+inline constexpr int kNativeCoordinateType = std::is_same_v<T, double>         ? FLOAT64
+                                             : std::is_same_v<T, float>        ? FLOAT32
+                                             : std::is_same_v<T, std::int32_t> ? INT32
+                                                                               : -1;
+
+/**
+ * @brief Reads the coordinate stored at `data`, which needs no alignment.
+ *
+ */
+inline double ReadCoordinate(const char* data, CoordinateType type) {
+  if (type != FLOAT64) {
+    std::uint32_t bits;
+    std::memcpy(&bits, data, sizeof(bits));
+    bits = LittleEndian(bits);
+    return type == FLOAT32 ? std::bit_cast<float>(bits) : std::bit_cast<std::int32_t>(bits);
+  }
+  std::uint64_t bits;
+  std::memcpy(&bits, data, sizeof(bits));
+  return std::bit_cast<double>(LittleEndian(bits));
+}
+
+inline bool IsBinaryPoints(std::string_view buffer) {
+  return buffer.size() >= sizeof(kBinaryMagic) &&
+         std::memcmp(buffer.data(), kBinaryMagic, sizeof(kBinaryMagic)) == 0;
+}
+
+/**
+ * @brief Decodes and validates the header of a binary point buffer.
+ *
+ * Returns nothing if the header is malformed, of an unknown version, or if the
+ * buffer is too short for the amount of points it announces.
+ */
+std::optional<BinaryHeader> ReadBinaryHeader(std::string_view buffer);
+
+// INT32 only takes whole coordinates in its range; others throw before
+// anything is written
+void WriteBinaryPoints(const std::string& filename, std::span<const Point> points,
+                       Layout layout = AOS, CoordinateType type = FLOAT64);
+// Appends the binary points to an open writer, e.g. a socket
+void WriteBinaryPoints(BufferedWriter& writer, std::span<const Point> points,
+                       Layout layout = AOS, CoordinateType type = FLOAT64);
+void WriteTextPoints(const std::string& filename, std::span<const Point> points);
+
+Layout ParseLayout(const std::string& name);
+
+/**
+ * Binary index files share the header layout of point files, with the magic
+ * "CYAI", the kind of result in place of the coordinate type, a zero byte and
+ * the amount of entries. They are followed by little-endian uint32 indices into
+ * the input points: one per hull vertex in counter-clockwise order, or two per
+ * EMST arc.
+ */
+enum IndexKind : std::uint8_t { HULL_INDICES = 0, TREE_INDICES = 1 };
+
+constexpr char kIndexMagic[4] = {'C', 'Y', 'A', 'I'};
+
+struct BinaryIndices {
+  IndexKind kind = HULL_INDICES;
+  std::uint64_t count = 0;
+  // Points straight into the buffer, two entries per arc for a tree
+  std::span<const PointIndex> indices;
+};
+
+void WriteHullIndices(const std::string& filename, std::span<const PointIndex> hull);
+void WriteTreeIndices(const std::string& filename, std::span<const IndexArc> tree);
+void WriteHullIndices(BufferedWriter& writer, std::span<const PointIndex> hull);
+void WriteTreeIndices(BufferedWriter& writer, std::span<const IndexArc> tree);
+
+// Bytes taken by the binary indices of a hull or of a tree with `count` entries
+inline size_t BinaryIndicesSize(IndexKind kind, size_t count) {
+  return kBinaryHeaderSize + count * (kind == TREE_INDICES ? 2 : 1) * sizeof(PointIndex);
+}
+
+/**
+ * @brief View of the indices of a binary index buffer, without copying them.
+ *
+ * The indices must be 4-byte aligned, which holds for a mapped file, and the
+ * host little-endian. Returns nothing otherwise or if the buffer is malformed.
+ */
+std::optional<BinaryIndices> ReadBinaryIndices(std::string_view buffer);
+
+}  // namespace cya
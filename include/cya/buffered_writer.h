@@ -0,0 +1,82 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo buffered_writer.h: Escritura de resultados con un búfer propio
+ * Referencias:
+ */
+
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cya {
+
+/**
+ * @brief Output file that formats into a reusable buffer and hands it to the
+ * kernel with one write(2) call per block.
+ *
+ * Numbers are formatted with std::to_chars, which is locale independent;
+ * doubles use the shortest representation that reads back to the same value.
+ * Nothing is flushed until the buffer is full or Close() is called, so
+ * Close() should be called to see write errors.
+ */
+class BufferedWriter {
+ public:
+  static constexpr size_t kBufferSize = 1 << 20;
+
+  // The name "-" writes to stdout
+  explicit BufferedWriter(const std::string& filename);
+  // Writes to an already open descriptor, which is not closed
+  explicit BufferedWriter(int descriptor);
+  ~BufferedWriter();
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  BufferedWriter& operator<<(std::string_view text);
+  BufferedWriter& operator<<(char character);
+  BufferedWriter& operator<<(double value);
+  BufferedWriter& operator<<(float value);
+  // Writes `value` with exactly `precision` decimals
+  BufferedWriter& WriteFixed(double value, int precision);
+
+  template <std::integral Integer>
+  BufferedWriter& operator<<(Integer value) {
+    Reserve(std::numeric_limits<Integer>::digits10 + 2);
+    const auto [end, error] = std::to_chars(End(), buffer_.data() + buffer_.size(), value);
+    used_ = end - buffer_.data();
+    return *this;
+  }
+
+  void Flush();
+  void Close();
+
+ private:
+  // Make room for `bytes` more characters
+  void Reserve(size_t bytes);
+  void WriteAll(const char* data, size_t size);
+  char* End() { return buffer_.data() + used_; }
+
+  std::string filename_;
+  int descriptor_ = -1;
+  bool owned_ = false;
+  std::vector<char> buffer_;
+  size_t used_ = 0;
+};
+
+}  // namespace cya
@@ -174,7 +174,8 @@ class ArgumentParser {
 
       if (arg.starts_with("--")) {
         ParseLongArgument(arg.substr(2), args, i);
-      } else if (arg.starts_with("-")) {
+      } else if (arg.starts_with("-") && arg != "-") {
+        // A lone "-" is a positional argument, conventionally stdin or stdout
         ParseShortArgument(arg.substr(1), args, i);
       } else {
         // Positional arguments are handled here
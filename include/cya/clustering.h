@@ -0,0 +1,45 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo clustering.h: Tipos del clustering single-linkage
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+// Cluster label of every point by original index, numbered from 0 in order of
+// first appearance
+using ClusterLabels = std::vector<int>;
+
+/**
+ * @brief One merge of the single-linkage dendrogram.
+ *
+ * Ids below the number of points n are single points, by original index; id
+ * n + m is the cluster created by the m-th merge.
+ */
+struct DendrogramMerge {
+  size_t left;
+  size_t right;
+  double distance;
+  size_t size;
+};
+
+using Dendrogram = std::vector<DendrogramMerge>;
+
+}  // namespace cya
@@ -0,0 +1,75 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo decompress.h: Descompresión gzip/zstd en segundo plano
+ * Referencias:
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace cya {
+
+enum Compression { NONE, GZIP, ZSTD };
+
+/**
+ * @brief Compression of a buffer, detected from its magic bytes.
+ *
+ */
+Compression DetectCompression(std::string_view buffer);
+
+/**
+ * @brief Decompresses a buffer on a background thread, handing out the
+ * decompressed data in blocks so the caller can parse one block while the next
+ * one is being decompressed.
+ *
+ * At most kMaxQueuedBlocks blocks are kept waiting, which bounds the memory in
+ * use. Decompression errors, including a format this build has no library for,
+ * are rethrown by Next().
+ */
+class DecompressStream {
+ public:
+  static constexpr size_t kBlockSize = 1 << 22;
+  static constexpr size_t kMaxQueuedBlocks = 4;
+
+  DecompressStream(std::string_view input, Compression compression);
+  ~DecompressStream();
+
+  DecompressStream(const DecompressStream&) = delete;
+  DecompressStream& operator=(const DecompressStream&) = delete;
+
+  // Next block in order, or nothing once the whole input has been handed out
+  std::optional<std::string> Next();
+
+ private:
+  void Run(std::string_view input, Compression compression);
+  // Queues a block; returns false if the consumer has gone away
+  bool Push(std::string block);
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<std::string> blocks_;
+  std::exception_ptr error_;
+  bool finished_ = false;
+  bool cancelled_ = false;
+  std::thread worker_;
+};
+
+}  // namespace cya
@@ -0,0 +1,74 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo disjoint_set.h: Estructura union-find sobre índices de puntos
+ * Referencias:
+ */
+
+#pragma once
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+/**
+ * @brief Union-find over point indices with union by size and path halving.
+ *
+ */
+class DisjointSet {
+ public:
+  explicit DisjointSet(size_t size) : parent_(size), size_(size, 1), components_(size) {
+    std::iota(parent_.begin(), parent_.end(), PointIndex{0});
+  }
+
+  PointIndex Find(PointIndex index) {
+    while (parent_[index] != index) {
+      parent_[index] = parent_[parent_[index]];
+      index = parent_[index];
+    }
+    return index;
+  }
+
+  /**
+   * @brief Joins the components of both indices.
+   *
+   * @return true if they were in different components.
+   */
+  bool Union(PointIndex a, PointIndex b) {
+    a = Find(a);
+    b = Find(b);
+    if (a == b) {
+      return false;
+    }
+    if (size_[a] < size_[b]) {
+      std::swap(a, b);
+    }
+    parent_[b] = a;
+    size_[a] += size_[b];
+    --components_;
+    return true;
+  }
+
+  inline size_t GetComponentCount() const { return components_; }
+  inline size_t GetComponentSize(PointIndex root) const { return size_[root]; }
+
+ private:
+  std::vector<PointIndex> parent_;
+  std::vector<size_t> size_;
+  size_t components_;
+};
+
+}  // namespace cya
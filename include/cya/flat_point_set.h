@@ -0,0 +1,109 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo flat_point_set.h: Conjunto de puntos con direccionamiento abierto
+ * Referencias:
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <vector>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+/**
+ * @brief Open-addressing hash set of points.
+ *
+ * Points live contiguously in insertion order and the probe table only holds
+ * their indices, so lookups touch one small array and iteration is a plain
+ * vector walk. Follows the std::set interface SubTree relies on.
+ */
+template <typename PointT>
+class BasicFlatPointSet {
+ public:
+  using value_type = PointT;
+  using const_iterator = typename std::vector<PointT>::const_iterator;
+
+  BasicFlatPointSet() = default;
+
+  bool emplace(const PointT& point) {
+    if (2 * (points_.size() + 1) > slots_.size()) {
+      Rehash(std::max<size_t>(kMinCapacity, 2 * slots_.size()));
+    }
+    const size_t slot = FindSlot(point);
+    if (slots_[slot] != kEmpty) {
+      return false;
+    }
+    slots_[slot] = points_.size();
+    points_.push_back(point);
+    return true;
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+      reserve(points_.size() + std::distance(first, last));
+    }
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  size_t count(const PointT& point) const {
+    return !slots_.empty() && slots_[FindSlot(point)] != kEmpty;
+  }
+
+  void reserve(size_t count) {
+    if (2 * count > slots_.size()) {
+      Rehash(std::bit_ceil(std::max<size_t>(kMinCapacity, 2 * count)));
+    }
+    points_.reserve(count);
+  }
+
+  inline size_t size() const { return points_.size(); }
+  inline bool empty() const { return points_.empty(); }
+  inline const_iterator begin() const { return points_.begin(); }
+  inline const_iterator end() const { return points_.end(); }
+
+ private:
+  static constexpr PointIndex kEmpty = ~PointIndex{0};
+  static constexpr size_t kMinCapacity = 8;
+
+  // Linear probing: the slot holding `point`, or the empty slot where it goes
+  size_t FindSlot(const PointT& point) const {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = PointHash{}(point) & mask;
+    while (slots_[slot] != kEmpty && points_[slots_[slot]] != point) {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void Rehash(size_t capacity) {
+    slots_.assign(capacity, kEmpty);
+    for (size_t i = 0; i < points_.size(); ++i) {
+      slots_[FindSlot(points_[i])] = i;
+    }
+  }
+
+  std::vector<PointT> points_;
+  std::vector<PointIndex> slots_;
+};
+
+using FlatPointSet = BasicFlatPointSet<Point>;
+
+}  // namespace cya
@@ -0,0 +1,61 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo geometry.h: Predicados geométricos genéricos en el tipo de coordenada
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+/**
+ * @brief Side of c with respect to the line from a to b: 1 if c is on the
+ * left (a counter-clockwise turn), -1 if it is on the right, 0 if the three
+ * points are collinear.
+ *
+ * Integer coordinates are exact: differences of int32 values fit in int64 and
+ * their products in 128 bits. Floating point coordinates are evaluated in
+ * double.
+ */
+template <typename PointT>
+int Orientation(const PointT& a, const PointT& b, const PointT& c) {
+  using Coordinate = CoordinateOf<PointT>;
+  if constexpr (std::is_integral_v<Coordinate>) {
+    static_assert(sizeof(Coordinate) <= sizeof(std::int32_t), "Coordinates wider than 32 bits");
+    const std::int64_t abx = std::int64_t{b.x} - a.x;
+    const std::int64_t aby = std::int64_t{b.y} - a.y;
+    const std::int64_t acx = std::int64_t{c.x} - a.x;
+    const std::int64_t acy = std::int64_t{c.y} - a.y;
+    const __int128 cross = static_cast<__int128>(abx) * acy - static_cast<__int128>(aby) * acx;
+    return (cross > 0) - (cross < 0);
+  } else {
+    const double cross = (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) -
+                         (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+    return (cross > 0) - (cross < 0);
+  }
+}
+
+// Squared distance in double, which holds any int32 difference exactly
+template <typename PointT>
+double SquaredDistance(const PointT& a, const PointT& b) {
+  const double dx = static_cast<double>(a.x) - b.x;
+  const double dy = static_cast<double>(a.y) - b.y;
+  return dx * dx + dy * dy;
+}
+
+}  // namespace cya
@@ -0,0 +1,68 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo graph_writer.h: Escritura de grafos en formato DOT y SVG
+ * Referencias:
+ */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "cya/buffered_writer.h"
+#include "cya/point_types.h"
+
+namespace cya {
+
+enum GraphFormat { DOT, SVG };
+
+/**
+ * @brief Streams a geometric graph over a set of points to a file.
+ *
+ * Nodes are identified by their point index. Edges are written in groups that
+ * share a color and a width, so a million-edge tree is a run of short lines in
+ * DOT and a single path in SVG. The SVG output already has the final layout and
+ * needs no `neato` pass; its y axis points up like the input coordinates.
+ */
+template <typename PointT>
+class BasicGraphWriter {
+ public:
+  BasicGraphWriter(const std::string& filename, GraphFormat format,
+                   std::span<const PointT> points);
+
+  void WriteNodes();
+  void WriteNodes(std::span<const PointIndex> indices);
+  void BeginEdges(std::string_view color, double width);
+  void WriteEdge(PointIndex from, PointIndex to);
+  void EndEdges();
+  void Close();
+
+ private:
+  void WriteNode(PointIndex index);
+  void WriteCoordinates(const PointT& point);
+
+  GraphFormat format_;
+  std::span<const PointT> points_;
+  // Decimals of the SVG coordinates
+  int precision_ = 2;
+  BufferedWriter writer_;
+};
+
+extern template class BasicGraphWriter<Point>;
+extern template class BasicGraphWriter<PointF>;
+extern template class BasicGraphWriter<PointI>;
+
+using GraphWriter = BasicGraphWriter<Point>;
+
+}  // namespace cya
@@ -0,0 +1,83 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo grid.h: Declaración del índice espacial de rejilla uniforme
+ * Referencias:
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+/**
+ * @brief Uniform grid over the bounding box of the points.
+ *
+ * The cell size is chosen from the density so that every cell holds about
+ * `points_per_cell` points. Buckets are stored CSR-style: the points of cell
+ * c are contiguous at [cell_start_[c], cell_start_[c + 1]). Neighbor queries
+ * walk the cells in square rings around the query, so on near-uniform data
+ * they only touch a handful of adjacent buckets.
+ *
+ * Like BasicKdTree, the grid stores points of type PointT and computes the
+ * cells and distances in double.
+ */
+template <typename PointT>
+class BasicUniformGrid {
+ public:
+  using PointVector = std::vector<PointT>;
+
+  static constexpr double kPointsPerCell = 2.0;
+
+  BasicUniformGrid() = default;
+  explicit BasicUniformGrid(std::span<const PointT> points,
+                            double points_per_cell = kPointsPerCell);
+
+  PointIndex Nearest(const PointT& query) const;
+  void KNearest(const PointT& query, size_t k, std::vector<Neighbor>& result) const;
+  void Radius(const PointT& query, double radius, std::vector<PointIndex>& result) const;
+
+  std::vector<PointIndex> Nearest(const PointVector& queries) const;
+  std::vector<PointIndex> KNearest(const PointVector& queries, size_t k) const;
+
+  inline size_t size() const { return points_.size(); }
+  inline bool empty() const { return points_.empty(); }
+  inline double GetCellSize() const { return cell_size_; }
+  inline size_t GetColumns() const { return columns_; }
+  inline size_t GetRows() const { return rows_; }
+
+ private:
+  size_t Column(double x) const;
+  size_t Row(double y) const;
+  void Offer(size_t cell, const PointT& query, size_t k, std::vector<Neighbor>& heap) const;
+
+  Point origin_ = {0, 0};
+  double cell_size_ = 1.0;
+  double inverse_cell_size_ = 1.0;
+  size_t columns_ = 0;
+  size_t rows_ = 0;
+  std::vector<PointIndex> cell_start_;
+  PointVector points_;
+  std::vector<PointIndex> indices_;
+};
+
+extern template class BasicUniformGrid<Point>;
+extern template class BasicUniformGrid<PointF>;
+extern template class BasicUniformGrid<PointI>;
+
+using UniformGrid = BasicUniformGrid<Point>;
+
+}  // namespace cya
@@ -0,0 +1,124 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo kdtree.h: Declaración del índice espacial k-d tree
+ * Referencias:
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cya/point_types.h"
+
+namespace cya {
+
+// Nearest neighbor of a point in each of the eight 45 degree octants around
+// it. Duplicates of the point lie in no octant; the first one takes the last
+// slot.
+constexpr size_t kOctants = 8;
+using OctantNeighbors = std::array<Neighbor, kOctants + 1>;
+
+// Octant of the offset (dx, dy): bit 2 when it points down, bit 1 when it
+// points left and bit 0 when it is closer to the y axis than to the x axis.
+// A zero offset maps to the duplicate slot, kOctants.
+inline size_t Octant(double dx, double dy) {
+  if (dx == 0 && dy == 0) {
+    return kOctants;
+  }
+  return size_t{dy < 0} << 2 | size_t{dx < 0} << 1 | size_t{std::abs(dy) > std::abs(dx)};
+}
+
+/**
+ * @brief 2-d tree with an implicit, pointer-free layout.
+ *
+ * Every node is the median of its range of the entry array: the node for
+ * [lo, hi) sits at lo + (hi - lo) / 2 with its children in the two halves.
+ * Ranges of at most kLeafSize entries are scanned linearly. Query results
+ * are indices into the point vector the tree was built from, shifted by
+ * `offset` when the tree only covers a slice of it.
+ *
+ * The tree stores points of type PointT, so float32 and int32 points take
+ * less memory; distances are always computed in double.
+ */
+template <typename PointT>
+class BasicKdTree {
+ public:
+  using PointVector = std::vector<PointT>;
+
+  BasicKdTree() = default;
+  explicit BasicKdTree(std::span<const PointT> points, PointIndex offset = 0);
+
+  PointIndex Nearest(const PointT& query) const;
+  void KNearest(const PointT& query, size_t k, std::vector<Neighbor>& result) const;
+  void AccumulateKNearest(const PointT& query, size_t k, std::vector<Neighbor>& heap) const;
+  void Radius(const PointT& query, double radius, std::vector<PointIndex>& result) const;
+  void Rectangle(const PointT& low, const PointT& high, std::vector<PointIndex>& result) const;
+
+  std::vector<PointIndex> Nearest(const PointVector& queries) const;
+  std::vector<PointIndex> KNearest(const PointVector& queries, size_t k) const;
+  void Radius(const PointVector& queries, double radius, std::vector<size_t>& offsets,
+              std::vector<PointIndex>& result) const;
+
+  // Lowers best[o] to the nearest point other than `self` in octant o of the
+  // query, see Octant()
+  void NearestInOctants(const PointT& query, PointIndex self, OctantNeighbors& best) const;
+
+  inline size_t size() const { return entries_.size(); }
+  inline bool empty() const { return entries_.empty(); }
+  inline PointIndex GetOffset() const { return offset_; }
+
+ private:
+  static constexpr size_t kLeafSize = 8;
+
+  struct Entry {
+    PointT point;
+    PointIndex index;
+    std::uint32_t axis;
+  };
+
+  // Bounding box of a range, narrowed at every split on the way down
+  struct Cell {
+    double min[2];
+    double max[2];
+  };
+
+  size_t Partition(size_t low, size_t high);
+  void Build(size_t low, size_t high);
+
+  void SearchKNearest(size_t low, size_t high, const PointT& query, size_t k,
+                      std::vector<Neighbor>& heap) const;
+  void SearchRadius(size_t low, size_t high, const PointT& query, double radius2,
+                    std::vector<PointIndex>& result) const;
+  void SearchRectangle(size_t low, size_t high, const PointT& min, const PointT& max,
+                       std::vector<PointIndex>& result) const;
+  void SearchOctants(size_t low, size_t high, const Cell& cell, const PointT& query,
+                     PointIndex self, OctantNeighbors& best) const;
+
+  std::vector<Entry> entries_;
+  PointIndex offset_ = 0;
+  PointT min_{};
+  PointT max_{};
+};
+
+extern template class BasicKdTree<Point>;
+extern template class BasicKdTree<PointF>;
+extern template class BasicKdTree<PointI>;
+
+using KdTree = BasicKdTree<Point>;
+
+}  // namespace cya
@@ -0,0 +1,56 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo mapped_file.h: Fichero proyectado en memoria de solo lectura
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cya {
+
+// File name that stands for the standard input or output
+inline constexpr std::string_view kStandardStream = "-";
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ */
+class MappedFile {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(const std::string& filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // Only regular files can be mapped; pipes and devices must be streamed
+  static bool IsRegularFile(const std::string& filename);
+
+  inline std::string_view GetView() const { return {data_, size_}; }
+  inline size_t size() const { return size_; }
+
+ private:
+  void Unmap();
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace cya
@@ -0,0 +1,96 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo parallel.h: Utilidades para repartir trabajo en bloques paralelos
+ * Referencias:
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "cya/scheduler.h"
+
+namespace cya {
+
+// Below this many items per chunk the parallel overhead is not worth it
+constexpr size_t kMinChunkSize = 1 << 14;
+// Items per task of ParallelFor() when every item is a query of its own
+constexpr size_t kQueryGrain = 256;
+
+/**
+ * @brief Number of chunks to split `count` items into, with at least
+ * `min_chunk_size` items per chunk.
+ *
+ */
+inline size_t ParallelChunkCount(size_t count, size_t min_chunk_size = kMinChunkSize) {
+  return std::clamp<size_t>(count / min_chunk_size, 1, Scheduler::Global().size());
+}
+
+/**
+ * @brief Calls `function(chunk, begin, end)` in parallel for every chunk of the
+ * range [0, count).
+ *
+ * Chunk bounds only depend on `count` and `chunks`, so several passes over the
+ * same range see the same split.
+ */
+template <typename Function>
+void ParallelChunks(size_t count, size_t chunks, Function&& function) {
+  Scheduler::Global().Run(chunks, [&](size_t chunk) {
+    function(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+  });
+}
+
+/**
+ * @brief Calls `function(i)` in parallel for every i in [0, count).
+ *
+ * Items are handed out `grain` at a time to whichever thread is free, so
+ * uneven items balance out; cheap items need a large grain.
+ */
+template <typename Function>
+void ParallelFor(size_t count, Function&& function, size_t grain = kMinChunkSize) {
+  const size_t tasks = (count + grain - 1) / grain;
+  Scheduler::Global().Run(tasks, [&](size_t task) {
+    const size_t end = std::min(count, (task + 1) * grain);
+    for (size_t i = task * grain; i < end; ++i) {
+      function(i);
+    }
+  });
+}
+
+/**
+ * @brief Sorts [first, last) with `compare`: every chunk is sorted on its own
+ * thread and then pairs of sorted runs are merged in parallel.
+ *
+ */
+template <typename Iterator, typename Compare>
+void ParallelSort(Iterator first, Iterator last, Compare compare) {
+  const size_t count = std::distance(first, last);
+  const size_t chunks = ParallelChunkCount(count);
+  ParallelChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+    std::sort(first + begin, first + end, compare);
+  });
+  for (size_t width = 1; width < chunks; width *= 2) {
+    const size_t merges = (chunks + 2 * width - 1) / (2 * width);
+    Scheduler::Global().Run(merges, [&](size_t merge) {
+      const size_t low = merge * 2 * width;
+      const size_t middle = std::min(chunks, low + width);
+      const size_t high = std::min(chunks, low + 2 * width);
+      std::inplace_merge(first + count * low / chunks, first + count * middle / chunks,
+                         first + count * high / chunks, compare);
+    });
+  }
+}
+
+}  // namespace cya
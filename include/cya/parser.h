@@ -17,17 +17,29 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <charconv>
 #include <concepts>
+#include <cstring>
 #include <expected>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "binary_format.h"
+#include "decompress.h"
+#include "mapped_file.h"
+#include "parallel.h"
 #include "point_types.h"
 
 namespace cya {
@@ -44,6 +56,10 @@ class ParseError : public std::runtime_error {
         context_(context),
         token_(token) {}
 
+  int GetLine() const { return line_; }
+  // Make the line number absolute when the error was found in a chunk
+  void OffsetLine(int lines) { line_ += lines; }
+
   const char* what() const noexcept override {
     static std::string full_message;
     const std::string red = "\033[1;31m";
@@ -72,6 +88,12 @@ class ParseError : public std::runtime_error {
   std::string token_;
 };
 
+// Byte counts of one ingestion, for reporting
+struct ParseStats {
+  size_t input_bytes = 0;   // Bytes of the input file or stream
+  size_t bytes_copied = 0;  // Bytes copied between buffers on the way to the result
+};
+
 // Concept to constrain point-like types
 template <typename T>
 concept PointType = requires(T a) {
@@ -86,91 +108,140 @@ class PointParser {
   // Type aliases
   using PointVector = std::vector<PointT>;
 
-  // Parse from a file with full error context
-  static std::expected<PointVector, ParseError> ParseFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
+  // Parse a file through a read-only memory mapping, without copying it. The
+  // name "-" stands for stdin; it and other files that cannot be mapped, such
+  // as named pipes, are streamed instead.
+  static std::expected<PointVector, ParseError> ParseFromFile(const std::string& filename,
+                                                             ParseStats* stats = nullptr) {
+    if (filename == kStandardStream) {
+      return ParseFromStream(std::cin, stats);
+    }
+    if (!MappedFile::IsRegularFile(filename)) {
+      std::ifstream input(filename, std::ios::binary);
+      if (!input) {
+        return std::unexpected(ParseError("Unable to open file", 0, 0, filename, "file_open"));
+      }
+      return ParseFromStream(input, stats);
+    }
+    MappedFile file;
+    try {
+      file = MappedFile(filename);
+    } catch (const std::exception& e) {
       return std::unexpected(ParseError("Unable to open file", 0, 0, filename, "file_open"));
     }
-    return ParseFromStream(file);
+    if (stats != nullptr) {
+      stats->input_bytes += file.size();
+    }
+    return ParseFromBuffer(file.GetView(), stats);
   }
 
-  // Parse from an input stream with comprehensive error handling
-  static std::expected<PointVector, ParseError> ParseFromStream(std::istream& input) {
-    PointVector points;
-    std::string line;
-    int line_number = 1;
-    std::string full_input_context;
+  // Parse from an input stream, e.g. stdin, block by block as it arrives, so
+  // parsing overlaps reading and the whole text is never held at once.
+  // Compressed streams are read whole first, since they are decompressed from
+  // a buffer.
+  static std::expected<PointVector, ParseError> ParseFromStream(std::istream& input,
+                                                               ParseStats* stats = nullptr) {
+    auto read_block = [&input, stats]() -> std::optional<std::string> {
+      std::string block(kStreamBlockSize, '\0');
+      input.read(block.data(), block.size());
+      block.resize(input.gcount());
+      if (block.empty()) {
+        return std::nullopt;
+      }
+      if (stats != nullptr) {
+        stats->input_bytes += block.size();
+        stats->bytes_copied += block.size();
+      }
+      return block;
+    };
 
-    // Capture full input context for error reporting
-    std::string input_context;
-    {
-      std::stringstream buffer;
-      buffer << input.rdbuf();
-      input_context = buffer.str();
-      input.clear();
-      input.seekg(0);
+    std::optional<std::string> first = read_block();
+    if (first && DetectCompression(*first) != NONE) {
+      std::string buffer = std::move(*first);
+      while (std::optional<std::string> block = read_block()) {
+        buffer += *block;
+      }
+      return ParseFromBuffer(buffer, stats);
     }
 
-    while (std::getline(input, line)) {
-      // Trim leading and trailing whitespace
-      line.erase(0, line.find_first_not_of(" \t"));
-      line.erase(line.find_last_not_of(" \t") + 1);
+    TextParser parser(first ? first->size() : 0, stats);
+    return ParseBlocks(
+        [&]() { return first ? std::exchange(first, std::nullopt) : read_block(); },
+        parser,
+        stats);
+  }
 
-      // Skip empty lines
-      if (line.empty()) {
-        line_number++;
-        continue;
-      }
+  // Parse a whole buffer in place: lines are scanned as string_views with
+  // std::from_chars, so nothing is allocated per line. The error context is
+  // only built when an error is actually reported. Compressed buffers are
+  // decompressed on the fly, see ParseFromCompressed().
+  static std::expected<PointVector, ParseError> ParseFromBuffer(std::string_view buffer,
+                                                               ParseStats* stats = nullptr) {
+    if (IsBinaryPoints(buffer)) {
+      return ParseFromBinary(buffer, stats);
+    }
+    if (const Compression compression = DetectCompression(buffer); compression != NONE) {
+      return ParseFromCompressed(buffer, compression, stats);
+    }
 
-      // try to parse amount of points
-      if (line_number == 1) {
-        int amount;
-        try {
-          amount = std::stoi(line);
-        } catch (const std::exception& e) {
-          return std::unexpected(ParseError(e.what(),
-                                            line_number,
-                                            0,  // Could be enhanced to track column
-                                            line,
-                                            line));
-        }
-        if (amount < 0) {
-          return std::unexpected(ParseError("Invalid amount of points",
-                                            line_number,
-                                            0,  // Could be enhanced to track column
-                                            line,
-                                            line));
-        }
-        line_number++;
-        continue;
-      }
+    TextParser parser(buffer.size() / 4, stats);
+    parser.Feed(buffer);
+    return parser.Finish();
+  }
 
-      try {
-        auto point_result = ParseSinglePoint(line, line_number, input_context);
-        if (point_result) {
-          points.push_back(*point_result);
-        } else {
-          return std::unexpected(point_result.error());
-        }
-      } catch (const std::exception& e) {
-        return std::unexpected(ParseError(e.what(),
-                                          line_number,
-                                          0,  // Could be enhanced to track column
-                                          line,
-                                          line));
-      }
-      line_number++;
+  // Parse a gzip or zstd compressed buffer. It is decompressed in blocks on a
+  // background thread while the previous block is being parsed, so nothing is
+  // decompressed to disk and only a few blocks are in memory at once.
+  static std::expected<PointVector, ParseError> ParseFromCompressed(std::string_view buffer,
+                                                                   Compression compression,
+                                                                   ParseStats* stats = nullptr) {
+    // A compressed byte rarely stands for a whole point, which bounds bogus amounts
+    TextParser parser(buffer.size(), stats);
+    try {
+      DecompressStream blocks(buffer, compression);
+      return ParseBlocks([&blocks]() { return blocks.Next(); }, parser, stats);
+    } catch (const std::exception& e) {
+      return std::unexpected(ParseError("Invalid compressed input", 0, 0, e.what(), ""));
     }
+  }
 
-    if (points.size() != std::stoi(input_context)) {
-      return std::unexpected(ParseError("Invalid amount of points",
-                                        line_number,
-                                        0,  // Could be enhanced to track column
-                                        line,
-                                        line));
+  // Decode a buffer in the binary point format. An AoS file whose coordinates
+  // are stored like those of PointT has exactly its memory layout, so it is
+  // loaded with a single copy; other files are converted coordinate by
+  // coordinate.
+  static std::expected<PointVector, ParseError> ParseFromBinary(std::string_view buffer,
+                                                               ParseStats* stats = nullptr) {
+    const std::optional<BinaryHeader> header = ReadBinaryHeader(buffer);
+    if (!header) {
+      return std::unexpected(ParseError("Invalid binary point file", 0, 0, "", ""));
     }
 
+    const size_t count = header->count;
+    const char* data = buffer.data() + kBinaryHeaderSize;
+    PointVector points(count);
+    using Coordinate = CoordinateOf<PointT>;
+    constexpr int native = kNativeCoordinateType<Coordinate>;
+    if constexpr (native >= 0 && sizeof(PointT) == 2 * sizeof(Coordinate) &&
+                  std::endian::native == std::endian::little) {
+      if (header->coordinate_type == native && header->layout == AOS) {
+        std::memcpy(points.data(), data, count * sizeof(PointT));
+        if (stats != nullptr) {
+          stats->bytes_copied += count * sizeof(PointT);
+        }
+        return points;
+      }
+    }
+
+    const CoordinateType type = header->coordinate_type;
+    const size_t size = CoordinateSize(type);
+    const size_t stride = header->layout == AOS ? 2 * size : size;
+    const size_t y_offset = header->layout == AOS ? size : count * size;
+    ParallelChunks(count, ParallelChunkCount(count), [&](size_t, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        points[i].x = static_cast<Coordinate>(ReadCoordinate(data + i * stride, type));
+        points[i].y = static_cast<Coordinate>(ReadCoordinate(data + y_offset + i * stride, type));
+      }
+    });
     return points;
   }
 
@@ -181,61 +252,599 @@ class PointParser {
     int line_number = 1;
 
     for (const auto& line : range) {
+      auto point_result = ParseLine(Trim(std::string_view(line)), line_number);
+      if (!point_result) {
+        return std::unexpected(point_result.error());
+      }
+      points.push_back(*point_result);
+      line_number++;
+    }
+
+    return points;
+  }
+
+  // Lazy input range over the points of a file, yielding them one at a time
+  // as they are parsed so consumers run in constant memory. Compressed inputs
+  // are decompressed block by block, while binary point files arriving through
+  // a stream or compressed are read whole, since they are decoded from a
+  // buffer. Iteration stops at the first error, which is then available
+  // through GetError().
+  class PointStream {
+   public:
+    class Iterator {
+     public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = PointT;
+      using difference_type = std::ptrdiff_t;
+
+      Iterator() = default;
+      explicit Iterator(PointStream* stream) : stream_(stream) {}
+
+      const PointT& operator*() const { return stream_->current_; }
+      Iterator& operator++() {
+        stream_->Advance();
+        return *this;
+      }
+      void operator++(int) { ++*this; }
+      bool operator==(std::default_sentinel_t) const { return stream_->done_; }
+
+     private:
+      PointStream* stream_ = nullptr;
+    };
+
+    explicit PointStream(std::istream& input) : input_(&input) {}
+    explicit PointStream(std::string_view buffer) : buffer_(buffer) {}
+    explicit PointStream(MappedFile file) : file_(std::move(file)), buffer_(file_.GetView()) {}
+    explicit PointStream(std::unique_ptr<std::istream> input)
+        : input_(input.get()), owned_input_(std::move(input)) {}
+
+    // The stream is consumed as it is iterated, so begin() is only valid once
+    Iterator begin() {
+      if (!started_) {
+        started_ = true;
+        Start();
+      }
+      return Iterator(this);
+    }
+    std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    const std::optional<ParseError>& GetError() const { return error_; }
+
+   private:
+    void Start() {
+      if (input_ != nullptr) {
+        SniffStream();
+      }
+      if (input_ == nullptr && DetectCompression(buffer_) != NONE && !StartDecompression()) {
+        return;
+      }
+      if (input_ == nullptr && IsBinaryPoints(buffer_)) {
+        binary_ = ReadBinaryHeader(buffer_);
+        if (!binary_) {
+          Fail(ParseError("Invalid binary point file", 0, 0, "", ""));
+          return;
+        }
+        amount_ = binary_->count;
+      }
+      Advance();
+    }
+
+    // Reads the first line of the stream to look for the binary or compression
+    // magic, which never holds a newline. Such a stream is read whole into
+    // held_ and parsed as a buffer; a text stream keeps the line for ReadLine().
+    void SniffStream() {
+      if (!std::getline(*input_, line_buffer_)) {
+        return;
+      }
+      if (!IsBinaryPoints(line_buffer_) && DetectCompression(line_buffer_) == NONE) {
+        first_line_ = true;
+        return;
+      }
+      held_ = std::move(line_buffer_);
+      if (!input_->eof()) {
+        held_ += '\n';
+      }
+      held_.append(std::istreambuf_iterator<char>(*input_), std::istreambuf_iterator<char>());
+      buffer_ = held_;
+      input_ = nullptr;
+    }
+
+    // Starts decompressing buffer_. A binary point file inside is collected
+    // whole and becomes buffer_; text is then read from the blocks.
+    bool StartDecompression() {
       try {
-        auto point_result = ParseSinglePoint(line, line_number, "");
-        if (!point_result) {
-          return std::unexpected(point_result.error());
+        blocks_ = std::make_unique<DecompressStream>(buffer_, DetectCompression(buffer_));
+        std::string first = blocks_->Next().value_or("");
+        if (!IsBinaryPoints(first)) {
+          block_ = std::move(first);
+          rest_ = block_;
+          return true;
+        }
+        while (std::optional<std::string> block = blocks_->Next()) {
+          first += *block;
         }
-        points.push_back(*point_result);
+        // The compressed data may live in held_, so it is replaced only now
+        blocks_.reset();
+        held_ = std::move(first);
+        buffer_ = held_;
+        return true;
       } catch (const std::exception& e) {
-        return std::unexpected(ParseError(e.what(), line_number, 0, line, line));
+        Fail(ParseError("Invalid compressed input", 0, 0, e.what(), ""));
+        return false;
       }
-      line_number++;
     }
 
-    return points;
+    void Advance() {
+      if (done_) {
+        return;
+      }
+      if (binary_) {
+        AdvanceBinary();
+        return;
+      }
+
+      std::string_view line;
+      while (ReadLine(line)) {
+        line = Trim(line);
+        line_number_++;
+
+        // Skip empty lines
+        if (line.empty()) {
+          continue;
+        }
+
+        // The first line holds the amount of points
+        if (!amount_) {
+          auto amount_result = ParseAmount(line, line_number_);
+          if (!amount_result) {
+            Fail(amount_result.error());
+            return;
+          }
+          amount_ = *amount_result;
+          continue;
+        }
+
+        auto point_result = ParseLine(line, line_number_);
+        if (!point_result) {
+          Fail(point_result.error());
+          return;
+        }
+        if (count_ == *amount_) {
+          Fail(ParseError("Invalid amount of points",
+                          line_number_,
+                          0,
+                          std::string(line),
+                          std::string(line)));
+          return;
+        }
+        current_ = *point_result;
+        count_++;
+        return;
+      }
+
+      // ReadLine() failed on its own
+      if (done_) {
+        return;
+      }
+      if (!amount_ || count_ != *amount_) {
+        Fail(ParseError("Invalid amount of points", line_number_, 0, "", ""));
+        return;
+      }
+      done_ = true;
+    }
+
+    void AdvanceBinary() {
+      if (count_ == *amount_) {
+        done_ = true;
+        return;
+      }
+      const CoordinateType type = binary_->coordinate_type;
+      const size_t size = CoordinateSize(type);
+      const char* data = buffer_.data() + kBinaryHeaderSize;
+      using Coordinate = CoordinateOf<PointT>;
+      if (binary_->layout == AOS) {
+        current_.x = static_cast<Coordinate>(ReadCoordinate(data + count_ * 2 * size, type));
+        current_.y = static_cast<Coordinate>(ReadCoordinate(data + count_ * 2 * size + size, type));
+      } else {
+        current_.x = static_cast<Coordinate>(ReadCoordinate(data + count_ * size, type));
+        current_.y =
+            static_cast<Coordinate>(ReadCoordinate(data + (*amount_ + count_) * size, type));
+      }
+      count_++;
+    }
+
+    bool ReadLine(std::string_view& line) {
+      if (blocks_ != nullptr) {
+        return ReadBlockLine(line);
+      }
+      if (input_ != nullptr) {
+        if (std::exchange(first_line_, false)) {
+          line = line_buffer_;
+          return true;
+        }
+        if (!std::getline(*input_, line_buffer_)) {
+          return false;
+        }
+        line = line_buffer_;
+        return true;
+      }
+      if (buffer_.empty()) {
+        return false;
+      }
+      line = NextLine(buffer_);
+      return true;
+    }
+
+    // Next line of the decompressed blocks, carrying the unfinished last line
+    // of each block over to the next one
+    bool ReadBlockLine(std::string_view& line) {
+      while (true) {
+        const size_t newline = rest_.find('\n');
+        if (newline != std::string_view::npos) {
+          line = rest_.substr(0, newline);
+          rest_.remove_prefix(newline + 1);
+          return true;
+        }
+        std::optional<std::string> next;
+        try {
+          next = blocks_->Next();
+        } catch (const std::exception& e) {
+          Fail(ParseError("Invalid compressed input", line_number_, 0, e.what(), ""));
+          return false;
+        }
+        if (!next) {
+          line = rest_;
+          rest_ = {};
+          return !line.empty();
+        }
+        block_ = std::string(rest_) + *next;
+        rest_ = block_;
+      }
+    }
+
+    void Fail(ParseError error) {
+      error_ = std::move(error);
+      done_ = true;
+    }
+
+    std::istream* input_ = nullptr;
+    std::unique_ptr<std::istream> owned_input_;  // A file that could not be mapped
+    MappedFile file_;
+    std::string held_;  // A binary or compressed input read whole
+    std::string_view buffer_;
+    std::string line_buffer_;
+    bool first_line_ = false;  // line_buffer_ holds the sniffed first line
+    std::unique_ptr<DecompressStream> blocks_;
+    std::string block_;      // Current decompressed block
+    std::string_view rest_;  // Unread part of block_
+    std::optional<BinaryHeader> binary_;
+    std::optional<size_t> amount_;
+    size_t count_ = 0;
+    int line_number_ = 0;
+    PointT current_{};
+    bool started_ = false;
+    bool done_ = false;
+    std::optional<ParseError> error_;
+  };
+
+  // Lazily parse a file through a memory mapping, or line by line when it
+  // cannot be mapped
+  static std::expected<PointStream, ParseError> StreamFromFile(const std::string& filename) {
+    if (filename == kStandardStream) {
+      return PointStream(std::cin);
+    }
+    if (!MappedFile::IsRegularFile(filename)) {
+      auto input = std::make_unique<std::ifstream>(filename, std::ios::binary);
+      if (!*input) {
+        return std::unexpected(ParseError("Unable to open file", 0, 0, filename, "file_open"));
+      }
+      return PointStream(std::unique_ptr<std::istream>(std::move(input)));
+    }
+    try {
+      return PointStream(MappedFile(filename));
+    } catch (const std::exception& e) {
+      return std::unexpected(ParseError("Unable to open file", 0, 0, filename, "file_open"));
+    }
   }
 
+  // Lazily parse an input stream line by line, or read it whole when it is
+  // binary or compressed
+  static PointStream StreamFromStream(std::istream& input) { return PointStream(input); }
+
+  // Lazily parse a buffer that outlives the stream
+  static PointStream StreamFromBuffer(std::string_view buffer) { return PointStream(buffer); }
+
  private:
-  // Advanced single point parsing with detailed validation
-  static std::expected<PointT, ParseError> ParseSinglePoint(const std::string& line,
-                                                            int line_number,
-                                                            const std::string& input_context) {
-    std::istringstream ss(line);
-    PointT point;
+  // Below this many bytes per chunk parsing is not worth spreading out
+  static constexpr size_t kMinChunkBytes = 1 << 20;
+  // Bytes read from a stream at a time, enough for a few parallel chunks
+  static constexpr size_t kStreamBlockSize = 1 << 22;
+
+  // Points parsed from one chunk of the buffer
+  struct Segment {
+    PointVector points;
+    int lines = 0;               // Lines scanned, including empty ones
+    std::string_view last_line;  // Last non-empty line, as error context
+    std::optional<ParseError> error;
+  };
+
+  // Incremental text parser, fed pieces of input that end at line boundaries.
+  //
+  // Large pieces are split at line boundaries into one chunk per thread, each
+  // chunk is parsed into its own segment and the segments are appended at their
+  // prefix-sum offsets. Error line numbers are made absolute by adding the lines
+  // counted in the preceding chunks.
+  class TextParser {
+   public:
+    // `max_points` bounds the space reserved for a bogus amount of points
+    TextParser(size_t max_points, ParseStats* stats) : max_points_(max_points), stats_(stats) {}
+
+    // Parse the lines of `text`; returns false once an error has been found
+    bool Feed(std::string_view text) {
+      if (error_) {
+        return false;
+      }
+
+      // The first non-empty line holds the amount of points
+      while (!amount_ && !text.empty()) {
+        const std::string_view line = Trim(NextLine(text));
+        line_number_++;
+        if (line.empty()) {
+          continue;
+        }
+        auto amount_result = ParseAmount(line, line_number_);
+        if (!amount_result) {
+          error_ = amount_result.error();
+          return false;
+        }
+        amount_ = *amount_result;
+        last_line_ = line;
+        points_.reserve(std::min(*amount_, max_points_));
+      }
+      if (text.empty()) {
+        return true;
+      }
+
+      const size_t chunks = ParallelChunkCount(text.size(), kMinChunkBytes);
+      std::vector<Segment> segments(chunks);
+      if (chunks == 1) {
+        // A single chunk is parsed straight into the result
+        segments.front().points = std::move(points_);
+        ParseSegment(text, 0, segments.front());
+        points_ = std::move(segments.front().points);
+        return Merge(segments.front());
+      }
+
+      std::vector<size_t> bounds(chunks + 1, text.size());
+      bounds[0] = 0;
+      for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        const size_t split = std::max(bounds[chunk - 1], text.size() * chunk / chunks);
+        const size_t newline = text.find('\n', split);
+        bounds[chunk] = newline == std::string_view::npos ? text.size() : newline + 1;
+      }
+
+      const size_t remaining = *amount_ - std::min(*amount_, points_.size());
+      ParallelChunks(chunks, chunks, [&](size_t chunk, size_t, size_t) {
+        const size_t bytes = bounds[chunk + 1] - bounds[chunk];
+        // Expect this chunk's share of the remaining points; a point takes at
+        // least four bytes, which bounds bogus amounts
+        const double share = static_cast<double>(remaining) * bytes / text.size();
+        const size_t expected = std::min(bytes / 4, static_cast<size_t>(share) + 1);
+        ParseSegment(text.substr(bounds[chunk], bytes), expected, segments[chunk]);
+      });
+
+      std::vector<size_t> offsets(chunks);
+      size_t total = points_.size();
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        offsets[chunk] = total;
+        total += segments[chunk].points.size();
+        if (!Merge(segments[chunk])) {
+          return false;
+        }
+      }
+
+      if (stats_ != nullptr) {
+        stats_->bytes_copied += (total - points_.size()) * sizeof(PointT);
+      }
+      points_.resize(total);
+      ParallelChunks(chunks, chunks, [&](size_t chunk, size_t, size_t) {
+        std::copy(segments[chunk].points.begin(),
+                  segments[chunk].points.end(),
+                  points_.begin() + offsets[chunk]);
+      });
+      return true;
+    }
+
+    std::expected<PointVector, ParseError> Finish() {
+      if (error_) {
+        return std::unexpected(*error_);
+      }
+      if (!amount_ || points_.size() != *amount_) {
+        return std::unexpected(ParseError("Invalid amount of points",
+                                          line_number_,
+                                          0,  // Could be enhanced to track column
+                                          last_line_,
+                                          last_line_));
+      }
+      return std::move(points_);
+    }
 
-    // Use std::from_chars for precise numeric parsing (C++17)
-    auto parse_coordinate = [&ss](double& coord) -> bool {
-      std::string coord_str;
-      if (!(ss >> coord_str))
+   private:
+    // Account for the lines of a parsed segment, in order
+    bool Merge(Segment& segment) {
+      if (segment.error) {
+        segment.error->OffsetLine(line_number_);
+        error_ = std::move(segment.error);
         return false;
+      }
+      line_number_ += segment.lines;
+      if (!segment.last_line.empty()) {
+        last_line_ = segment.last_line;
+      }
+      return true;
+    }
+
+    size_t max_points_;
+    ParseStats* stats_;
+    PointVector points_;
+    std::optional<size_t> amount_;
+    int line_number_ = 0;
+    std::string last_line_;
+    std::optional<ParseError> error_;
+  };
+
+  // Feeds the blocks returned by `next` to the parser, carrying the unfinished
+  // last line of each block over to the next one. A binary point file is
+  // collected whole and decoded at the end.
+  template <typename NextBlock>
+  static std::expected<PointVector, ParseError> ParseBlocks(NextBlock&& next,
+                                                            TextParser& parser,
+                                                            ParseStats* stats) {
+    std::string pending;  // Unfinished last line of the previous block
+    std::string binary;   // Binary point files are decoded once complete
+    bool first = true;
+    bool is_binary = false;
+    while (std::optional<std::string> block = next()) {
+      is_binary = is_binary || (std::exchange(first, false) && IsBinaryPoints(*block));
+      if (is_binary) {
+        binary += *block;
+        continue;
+      }
+
+      std::string_view text = *block;
+      if (!pending.empty()) {
+        const size_t newline = text.find('\n');
+        if (newline == std::string_view::npos) {
+          pending += text;
+          continue;
+        }
+        pending += text.substr(0, newline + 1);
+        text.remove_prefix(newline + 1);
+        if (!parser.Feed(pending)) {
+          break;
+        }
+        pending.clear();
+      }
+      const size_t last_newline = text.rfind('\n');
+      const size_t complete = last_newline == std::string_view::npos ? 0 : last_newline + 1;
+      if (!parser.Feed(text.substr(0, complete))) {
+        break;
+      }
+      pending.assign(text.substr(complete));
+    }
+
+    if (!binary.empty()) {
+      return ParseFromBinary(binary, stats);
+    }
+    parser.Feed(pending);
+    return parser.Finish();
+  }
+
+  // Parse every line of a chunk; error line numbers are relative to it
+  static void ParseSegment(std::string_view text, size_t expected, Segment& segment) {
+    segment.points.reserve(expected);
+    while (!text.empty()) {
+      const std::string_view line = Trim(NextLine(text));
+      segment.lines++;
+
+      // Skip empty lines
+      if (line.empty()) {
+        continue;
+      }
+
+      auto point_result = ParseLine(line, segment.lines);
+      if (!point_result) {
+        segment.error = point_result.error();
+        return;
+      }
+      segment.points.push_back(*point_result);
+      segment.last_line = line;
+    }
+  }
+
+  // Split the next line, without its newline, off the front of `text`
+  static std::string_view NextLine(std::string_view& text) {
+    const void* newline = std::memchr(text.data(), '\n', text.size());
+    const size_t length =
+        newline == nullptr ? text.size() : static_cast<const char*>(newline) - text.data();
+    const std::string_view line = text.substr(0, length);
+    text.remove_prefix(std::min(length + 1, text.size()));
+    return line;
+  }
+
+  static bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+  static std::string_view Trim(std::string_view line) {
+    while (!line.empty() && IsBlank(line.front())) {
+      line.remove_prefix(1);
+    }
+    while (!line.empty() && IsBlank(line.back())) {
+      line.remove_suffix(1);
+    }
+    return line;
+  }
+
+  static std::expected<size_t, ParseError> ParseAmount(std::string_view line, int line_number) {
+    long long amount = 0;
+    auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), amount);
+    if (ec != std::errc() || ptr != line.data() + line.size() || amount < 0) {
+      return std::unexpected(ParseError("Invalid amount of points",
+                                        line_number,
+                                        0,  // Could be enhanced to track column
+                                        std::string(line),
+                                        std::string(line)));
+    }
+    return static_cast<size_t>(amount);
+  }
 
-      double value;
-      auto [ptr, ec] =
-          std::from_chars(coord_str.data(), coord_str.data() + coord_str.size(), value);
+  // Single point parsing with detailed validation over a trimmed line
+  static std::expected<PointT, ParseError> ParseLine(std::string_view line, int line_number) {
+    const char* cursor = line.data();
+    const char* const end = line.data() + line.size();
+    PointT point;
 
-      if (ec != std::errc())
+    // A coordinate is a whole whitespace-delimited token. Integer coordinates
+    // are read as integers, so "1.5" or an out of range value is an error.
+    auto parse_coordinate = [&](auto& coord) -> bool {
+      while (cursor < end && IsBlank(*cursor)) {
+        ++cursor;
+      }
+      using Coordinate = std::remove_cvref_t<decltype(coord)>;
+      std::conditional_t<std::is_integral_v<Coordinate>, Coordinate, double> value;
+      auto [ptr, ec] = std::from_chars(cursor, end, value);
+      if (ec != std::errc() || (ptr < end && !IsBlank(*ptr))) {
         return false;
-      coord = value;
+      }
+      coord = static_cast<Coordinate>(value);
+      cursor = ptr;
       return true;
     };
 
     // Parse x coordinate
     if (!parse_coordinate(point.x)) {
-      return std::unexpected(ParseError("Invalid x-coordinate", line_number, 1, line, line));
+      return std::unexpected(
+          ParseError("Invalid x-coordinate", line_number, 1, std::string(line), std::string(line)));
     }
 
     // Parse y coordinate
     if (!parse_coordinate(point.y)) {
-      return std::unexpected(ParseError(
-          "Invalid y-coordinate", line_number, line.find_first_of(" \t") + 1, line, line));
+      return std::unexpected(ParseError("Invalid y-coordinate",
+                                        line_number,
+                                        line.find_first_of(" \t") + 1,
+                                        std::string(line),
+                                        std::string(line)));
     }
 
     // Check for extra tokens
-    std::string extra;
-    if (ss >> extra) {
-      return std::unexpected(
-          ParseError("Extra tokens after coordinates", line_number, line.size(), line, extra));
+    while (cursor < end && IsBlank(*cursor)) {
+      ++cursor;
+    }
+    if (cursor != end) {
+      return std::unexpected(ParseError("Extra tokens after coordinates",
+                                        line_number,
+                                        line.size(),
+                                        std::string(line),
+                                        std::string(cursor, end)));
     }
 
     return point;
@@ -244,14 +853,13 @@ class PointParser {
 
 // Convenience functions
 template <PointType PointT = Point>
-inline auto ParsePointsFromFile(const std::string& filename) {
-  return PointParser<PointT>::ParseFromFile(filename);
+inline auto ParsePointsFromFile(const std::string& filename, ParseStats* stats = nullptr) {
+  return PointParser<PointT>::ParseFromFile(filename, stats);
 }
 
 template <PointType PointT = Point>
 inline auto ParsePointsFromString(const std::string& input_string) {
-  std::istringstream ss(input_string);
-  return PointParser<PointT>::ParseFromStream(ss);
+  return PointParser<PointT>::ParseFromBuffer(input_string);
 }
 
-}  // namespace cya
\ No newline at end of file
+}  // namespace cya
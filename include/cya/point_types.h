@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <bit>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -47,6 +51,48 @@ struct Point {
   friend std::istream& operator>>(std::istream& is, Point& ps);
 };
 
+/**
+ * @brief Point with compact coordinates, for float32 and int32 data.
+ *
+ * Point keeps its doubles; BasicPoint<double> has the same layout.
+ */
+template <typename T>
+struct BasicPoint {
+  using Coordinate = T;
+
+  T x;
+  T y;
+
+  bool operator==(const BasicPoint& other) const = default;
+  bool operator<(const BasicPoint& other) const {
+    return x < other.x || (x == other.x && y < other.y);
+  }
+};
+
+using PointF = BasicPoint<float>;
+using PointI = BasicPoint<std::int32_t>;
+
+// Coordinate type of Point and of every BasicPoint
+template <typename PointT>
+using CoordinateOf = std::remove_cvref_t<decltype(PointT::x)>;
+
+/**
+ * @brief Hash over the bit patterns of the coordinates.
+ *
+ * Coordinates are widened to double, which is exact for every point type.
+ * Adding 0.0 folds -0.0 into 0.0 so points equal under operator== hash alike.
+ */
+struct PointHash {
+  template <typename PointT>
+  size_t operator()(const PointT& point) const {
+    const std::uint64_t x = std::bit_cast<std::uint64_t>(static_cast<double>(point.x) + 0.0);
+    const std::uint64_t y = std::bit_cast<std::uint64_t>(static_cast<double>(point.y) + 0.0);
+    std::uint64_t hash = x * 0x9E3779B97F4A7C15ull ^ (y + 0x632BE59BD9B4E019ull);
+    hash ^= hash >> 32;
+    return std::hash<std::uint64_t>{}(hash * 0xD6E8FEB86659FD93ull);
+  }
+};
+
 using Line = std::pair<Point, Point>;
 using PointVector = std::vector<Point>;
 using Arc = Line;
@@ -55,6 +101,14 @@ using ArcVector = std::vector<WeightedArc>;
 using PointCollection = std::set<Point>;
 using Tree = std::vector<Arc>;
 
+// Arcs expressed as indices into the owning point vector
+using PointIndex = std::uint32_t;
+using IndexArc = std::pair<PointIndex, PointIndex>;
+using IndexTree = std::vector<IndexArc>;
+
+// Result of neighbor queries: squared distance to the query and point index
+using Neighbor = std::pair<double, PointIndex>;
+
 enum Side { LEFT = -1, CENTER, RIGHT };
 
 std::ostream& operator<<(std::ostream& os, const PointVector& ps);
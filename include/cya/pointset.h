@@ -10,66 +10,165 @@
  * Autor: Pablo Hernández Jiménez
  * Correo: alu0101495934@ull.edu.es
  * Fecha: 19/09/2024
- * Archivo pointset.h: Declaración de la clase PointSet
+ * Archivo pointset.h: Declaración de la clase BasicPointSet
  * Referencias:
  */
 
 #pragma once
 
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cya/binary_format.h"
+#include "cya/clustering.h"
+#include "cya/disjoint_set.h"
+#include "cya/graph_writer.h"
+#include "cya/grid.h"
+#include "cya/kdtree.h"
 #include "cya/point_types.h"
+#include "cya/radix_sort.h"
+#include "cya/space_filling.h"
 #include "cya/subtree.h"
 
 namespace cya {
 
-using Forest = std::vector<SubTree>;
-
-class PointSet : public PointVector {
+/**
+ * @brief Points together with their convex hull and EMST.
+ *
+ * Generic over the point type like BasicKdTree: Point, PointF and PointI are
+ * instantiated, so float32 and int32 inputs run the same hull and EMST
+ * engines in less memory. Distances are always computed in double and the
+ * side of a point with respect to a line is exact for integer coordinates.
+ */
+template <typename PointT>
+class BasicPointSet : public std::vector<PointT> {
  public:
-  PointSet(const PointVector& points) : PointVector(points) {}
+  using PointVector = std::vector<PointT>;
+  using Line = std::pair<PointT, PointT>;
+  using Arc = Line;
+  using Tree = std::vector<Arc>;
+  using SubTree = BasicSubTree<BasicFlatPointSet<PointT>>;
+  using Forest = std::vector<SubTree>;
+  using KdTree = BasicKdTree<PointT>;
+  using UniformGrid = BasicUniformGrid<PointT>;
+  using GraphWriter = BasicGraphWriter<PointT>;
+
+  BasicPointSet(const PointVector& points) : PointVector(points) {}
+  BasicPointSet(PointVector&& points) : PointVector(std::move(points)) {}
+
+  // The base depends on PointT, so the members used unqualified are named here
+  using PointVector::begin;
+  using PointVector::data;
+  using PointVector::empty;
+  using PointVector::end;
+  using PointVector::front;
+  using PointVector::insert;
+  using PointVector::size;
 
   void EMST();
   void EMSTImproved(int start_point = 0);
-  PointSet EMSTMultistart();
+  void EMSTMultistart();
+  void EMSTSparse();
+  void AddPoints(const PointVector& batch);
   void QuickHull();
   void QuickHullImproved();
+  void SpatialReorder(Curve curve = HILBERT);
+
+  ClusterLabels ClusterByDistance(double threshold) const;
+  ClusterLabels ClusterByCount(size_t clusters) const;
+  Dendrogram ComputeDendrogram() const;
 
   void WriteDot(const std::string& filename) const;
-  void Write(const std::string& filename) const;
+  void WriteGraph(const std::string& filename, GraphFormat format) const;
+  void WriteDecimatedGraph(const std::string& filename, GraphFormat format, size_t resolution,
+                           double min_edge_length = 0.0) const;
+  void Write(const std::string& filename, PointFormat format = TEXT) const;
+  void WriteTree(const std::string& filename) const;
+  void WriteIndices(const std::string& filename, IndexKind kind) const;
+  void WriteClusters(const std::string& filename, const ClusterLabels& labels) const;
+  void WriteDendrogram(const std::string& filename, const Dendrogram& dendrogram) const;
 
-  inline const Tree& GetTree() const { return emst_; }
+  const Tree& GetTree() const;
+  inline const IndexTree& GetIndexTree() const { return tree_; }
   inline const PointVector& GetPoints() const { return *this; }
   inline const double GetCost() const { return ComputeCost(); }
   inline const PointVector& GetHull() const { return hull_; }
-  inline const int GetPointOrder(const Point& point) const {
-    int order = 0;
-    for (const auto& arc : emst_) {
-      if (arc.first == point || arc.second == point) {
-        ++order;
-      }
-    }
-    return order;
+  std::vector<PointIndex> GetHullIndices() const;
+  IndexTree GetTreeIndices() const;
+  inline int GetDegree(PointIndex index) const {
+    return index < degree_.size() ? degree_[index] : 0;
+  }
+  std::span<const PointIndex> GetNeighbors(PointIndex index) const;
+  inline const int GetPointOrder(const PointT& point) const {
+    const std::optional<PointIndex> index = FindPoint(point);
+    return index ? GetDegree(*index) : 0;
+  }
+  std::vector<int> GetPointOrders(const PointVector& points) const;
+  std::optional<PointIndex> FindPoint(const PointT& point) const;
+  inline PointIndex GetOriginalIndex(PointIndex index) const {
+    return permutation_.empty() ? index : permutation_[index];
   }
+  inline const std::vector<PointIndex>& GetPermutation() const { return permutation_; }
+  const KdTree& GetKdTree() const;
+  const UniformGrid& GetGrid() const;
 
  private:
   void QuickHull(const Line& line, int side);
   void QuickHullImproved(const Line& line, int side);
-  void ComputeArcVector(ArcVector& arcs) const;
+  void ComputeArcVector(IndexTree& arcs, std::vector<RadixRecord>& order) const;
   void FindIncidentSubtrees(const Forest& forest, const Arc& arc, int& i, int& j) const;
   void MergeSubtrees(Forest& forest, const Arc& arc, int i, int j);
-  int FindSide(const Line& line, const Point& p) const;
-  void XBounds(Point& min_x, Point& max_x) const;
-  double PointToLine(const Line& line, const Point& point) const;
-  bool FarthestPoint(const Line& line, int side, Point& farthest) const;
-  bool FarthestPointImproved(const Line& line, int side, Point& farthest) const;
-  double Distance(const Line& line, const Point& point) const;
+  void UpdateIndex();
+  void OctantNeighborGraph(PointIndex first, IndexTree& candidates) const;
+  void KruskalOnCandidates(const IndexTree& candidates, DisjointSet& components,
+                           IndexTree& tree) const;
+  void SetTree(IndexTree tree);
+  void SortTreeByLength();
+  const std::unordered_map<PointT, PointIndex, PointHash>& GetPointIndex() const;
+  void LinkageOrder(std::vector<std::pair<double, IndexArc>>& arcs) const;
+  ClusterLabels LabelComponents(DisjointSet& components) const;
+  std::vector<PointIndex> InputOrder() const;
+  std::vector<PointIndex> HullIndices() const;
+  void WriteHullEdges(GraphWriter& writer, const std::vector<PointIndex>& hull) const;
+  int FindSide(const Line& line, const PointT& p) const;
+  void XBounds(PointT& min_x, PointT& max_x) const;
+  double PointToLine(const Line& line, const PointT& point) const;
+  bool FarthestPoint(const Line& line, int side, PointT& farthest) const;
+  bool FarthestPointImproved(const Line& line, int side, PointT& farthest) const;
+  double Distance(const Line& line, const PointT& point) const;
 
   double ComputeCost() const;
 
   double EuclideanDistance(const Arc& arc) const;
+  double SquaredDistance(const PointT& a, const PointT& b) const;
 
  private:
-  Tree emst_;
+  // Tree as pairs of points, only materialized when GetTree() is called
+  mutable Tree emst_;
+  IndexTree tree_;
+  std::vector<PointIndex> degree_;
+  // CSR adjacency of the tree, built on the first GetNeighbors()
+  mutable std::vector<PointIndex> adjacency_offsets_;
+  mutable std::vector<PointIndex> adjacency_;
+  // Squared length keys of tree_ while it is sorted by length, see AddPoints()
+  std::vector<std::uint64_t> tree_keys_;
+  // Built on the first lookup after the tree changes, see GetPointIndex()
+  mutable std::unordered_map<PointT, PointIndex, PointHash> point_index_;
   PointVector hull_;
+  // Original index of every point after SpatialReorder(), empty if unsorted
+  std::vector<PointIndex> permutation_;
+  // k-d trees over consecutive slices of the points, see UpdateIndex()
+  mutable std::vector<KdTree> index_levels_;
+  mutable std::optional<UniformGrid> grid_;
 };
 
+extern template class BasicPointSet<Point>;
+extern template class BasicPointSet<PointF>;
+extern template class BasicPointSet<PointI>;
+
+using PointSet = BasicPointSet<Point>;
+
 }  // namespace cya
\ No newline at end of file
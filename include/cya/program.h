@@ -16,15 +16,19 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "cya/cli.h"
 #include "cya/point_types.h"
+#include "cya/space_filling.h"
 
 namespace cya {
 
-class PointSet;
+template <typename PointT>
+class BasicPointSet;
+struct ParseStats;
 
 /**
  * @brief Main program class
@@ -37,13 +41,33 @@ class Program {
   void Run();
 
  private:
+  void RunConvert();
+  void RunBatch();
+  void RunServe();
+  void RunLoad();
+  void RunCheck();
   void RunBenchmarks();
-  void ProcessInput(const std::string& input, const std::string& output_filename,
+  template <typename PointT>
+  size_t ProcessFile(const std::string& input_filename, const std::string& output_filename,
+                     const cli::ArgumentParser& parser, ParseStats* stats);
+  template <typename PointT>
+  void ProcessInput(std::vector<PointT> points, const std::string& output_filename,
                     const cli::ArgumentParser& parser);
-  PointSet Process(const PointVector& points);
-  PointSet ProcessImproved(const PointVector& points);
-  PointSet ProcessMultistart(const PointVector& points);
-  PointSet ProcessRandom(const PointVector& points);
+  template <typename PointT>
+  void ProcessClusters(std::vector<PointT> points, const std::string& output_filename,
+                       const cli::ArgumentParser& parser);
+  template <typename PointT>
+  BasicPointSet<PointT> Process(std::vector<PointT> points);
+  template <typename PointT>
+  BasicPointSet<PointT> ProcessImproved(std::vector<PointT> points);
+  template <typename PointT>
+  BasicPointSet<PointT> ProcessEMST(std::vector<PointT> points, const std::string& engine,
+                                    std::optional<Curve> curve = std::nullopt);
+  template <typename PointT>
+  BasicPointSet<PointT> ProcessMultistart(const std::vector<PointT>& points,
+                                          std::optional<Curve> curve = std::nullopt);
+  template <typename PointT>
+  BasicPointSet<PointT> ProcessRandom(const std::vector<PointT>& points);
 
   std::vector<std::string> arguments_;
 };
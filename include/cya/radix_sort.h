@@ -0,0 +1,51 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo radix_sort.h: Ordenación radix LSD paralela de claves de 64 bits
+ * Referencias:
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace cya {
+
+/**
+ * @brief Compact sort record: a 64-bit key and the index of the item it
+ * belongs to.
+ *
+ */
+struct RadixRecord {
+  std::uint64_t key;
+  std::uint32_t index;
+};
+
+/**
+ * @brief Maps a double to an unsigned key with the same ordering.
+ *
+ */
+inline std::uint64_t OrderedKey(double value) {
+  const std::uint64_t bits = std::bit_cast<std::uint64_t>(value);
+  return (bits >> 63) ? ~bits : bits | (std::uint64_t{1} << 63);
+}
+
+/**
+ * @brief Stable parallel LSD radix sort of the records by key.
+ *
+ * Passes where every key shares the same digit are skipped.
+ */
+void RadixSort(std::vector<RadixRecord>& records);
+
+}  // namespace cya
@@ -0,0 +1,91 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo scheduler.h: Planificador global del trabajo en paralelo
+ * Referencias:
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cya {
+
+/**
+ * @brief The threads every parallel loop of cya runs on.
+ *
+ * The global scheduler has `size()` threads counting the caller: Run() hands
+ * the tasks out to size() - 1 workers and takes some itself. Only one loop
+ * runs on the workers at a time. A loop started from a worker, from a
+ * ThreadPool task, or while another loop is running, runs on the calling
+ * thread alone, so nesting or concurrent callers never add threads.
+ *
+ * The amount of threads is set with Configure(), or else with the CYA_THREADS
+ * environment variable, or else it is the hardware concurrency. With pinning,
+ * thread i is bound to the i-th CPU the process may run on, so several
+ * instances can be given disjoint CPU sets with taskset.
+ */
+class Scheduler {
+ public:
+  Scheduler(size_t threads, bool pin);
+  ~Scheduler();
+
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  // Upper bound of every thread count, far above any real machine
+  static constexpr size_t kMaxThreads = 4096;
+
+  static Scheduler& Global();
+  // Replaces the global scheduler, with the default amount of threads if
+  // `threads` is 0; no parallel work may be running
+  static void Configure(size_t threads, bool pin);
+  // CYA_THREADS if it is set, otherwise the hardware concurrency
+  static size_t DefaultThreadCount();
+  // Makes the parallel loops started from this thread run on it alone
+  static void MarkWorkerThread();
+
+  // Calls `function(task)` for every task in [0, tasks) and waits for them.
+  // The first exception thrown by a task is rethrown.
+  void Run(size_t tasks, const std::function<void(size_t)>& function);
+
+  inline size_t size() const { return workers_.size() + 1; }
+
+ private:
+  void WorkerLoop(size_t index);
+  void Work();
+
+  std::mutex run_mutex_;  // Held by the caller whose loop is on the workers
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_t)>* job_ = nullptr;
+  size_t tasks_ = 0;
+  std::atomic<size_t> next_ = 0;
+  std::uint64_t generation_ = 0;
+  size_t active_ = 0;  // Workers inside Work()
+  std::exception_ptr error_;
+  bool stopping_ = false;
+  std::vector<int> cpus_;  // CPU of every thread when pinning, caller first
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace cya
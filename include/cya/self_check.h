@@ -0,0 +1,44 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo self_check.h: Comprobación de los motores contra fuerza bruta
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace cya {
+
+struct CheckOptions {
+  size_t trials = 20;      // Random inputs per check
+  std::uint64_t seed = 1;  // Seed of the random inputs
+};
+
+struct CheckSummary {
+  size_t passed = 0;
+  size_t failed = 0;
+};
+
+/**
+ * @brief Compares the fast engines and indexes with brute force, or with the
+ * reference engine, on random uniform, clustered and lattice inputs.
+ *
+ * Every check is reported on `report` as PASS or FAIL, the latter with the
+ * first trial that failed.
+ */
+CheckSummary RunSelfChecks(const CheckOptions& options, std::ostream& report);
+
+}  // namespace cya
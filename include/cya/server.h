@@ -0,0 +1,148 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo server.h: Servicio de envolventes y EMST sobre un socket Unix
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "cya/buffered_writer.h"
+#include "cya/point_types.h"
+#include "cya/thread_pool.h"
+
+namespace cya {
+
+/**
+ * Requests and responses are frames with the 16 byte header layout of point
+ * files:
+ *
+ *   offset 0   magic "CYAQ" for a request, "CYAR" for a response
+ *   offset 4   uint16 version
+ *   offset 6   uint8 request kind (RequestKind) or response status
+ *   offset 7   zero
+ *   offset 8   uint64 length of the payload
+ *
+ * A request payload is a binary point file in any coordinate type and
+ * layout. A successful response carries a binary index file with the hull in
+ * counter-clockwise order or the EMST arcs; a failed one carries the error
+ * message. A connection may send any amount of requests, one after another.
+ */
+enum RequestKind : std::uint8_t { HULL_REQUEST = 0, EMST_REQUEST = 1 };
+enum ResponseStatus : std::uint8_t { RESPONSE_OK = 0, RESPONSE_ERROR = 1 };
+
+constexpr char kRequestMagic[4] = {'C', 'Y', 'A', 'Q'};
+constexpr char kResponseMagic[4] = {'C', 'Y', 'A', 'R'};
+// Largest request payload a server reads unless told otherwise, about 16
+// million double points; the payload is allocated before it arrives
+constexpr size_t kDefaultMaxPayload = size_t{256} << 20;
+
+/**
+ * @brief Per-thread scratch memory for the request payloads.
+ *
+ * Payloads are carved from one block that is reused by every request. When a
+ * request needs more, the overflow comes from the heap and the block grows to
+ * the high-water mark on the next Reset(), so a warm worker stops allocating
+ * for them. The decoded points and the results still use the heap.
+ */
+class ScratchArena {
+ public:
+  explicit ScratchArena(size_t bytes = 1 << 20);
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // Frees everything handed out since the last Reset()
+  void Reset();
+  inline std::pmr::memory_resource* GetResource() { return &*resource_; }
+
+ private:
+  // Heap upstream that remembers how much it handed out
+  class CountingResource : public std::pmr::memory_resource {
+   public:
+    size_t allocated = 0;
+
+   private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+  };
+
+  std::vector<std::byte> block_;
+  CountingResource upstream_;
+  std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+/**
+ * @brief Answers hull and EMST requests with warm threads.
+ *
+ * Idle connections wait in a poll loop; each request that arrives is handed
+ * to one worker of a fixed pool, which keeps its scratch arena between
+ * requests, and the connection goes back to the loop once it is answered. A
+ * client that stalls in the middle of a frame is dropped after a timeout,
+ * and a request larger than `max_payload` bytes is refused before any memory
+ * is set aside for it. The geometry runs on BasicPointSet in the coordinate
+ * type of the request.
+ */
+class Server {
+ public:
+  explicit Server(size_t workers, size_t max_payload = kDefaultMaxPayload)
+      : max_payload_(max_payload), pool_(workers) {}
+  ~Server();
+
+  // Accepts connections on a Unix domain socket until the process ends
+  void ServeSocket(const std::string& path);
+  // Serves a single connection made of two descriptors, e.g. stdin and stdout
+  static void ServeConnection(int input, int output, size_t max_payload = kDefaultMaxPayload);
+
+ private:
+  // Answers the next request, or returns false if the client closed instead
+  static bool ServeRequest(int input, BufferedWriter& writer, size_t max_payload);
+  // Hands a connection back to the poll loop after a request
+  void Resume(int connection);
+
+  size_t max_payload_;
+  std::mutex mutex_;
+  std::vector<int> resumed_;
+  int wake_[2] = {-1, -1};  // Pipe that interrupts the poll loop
+  // Last, so the workers stop before the members they use go away
+  ThreadPool pool_;
+};
+
+struct LoadSummary {
+  size_t requests = 0;
+  size_t failed = 0;
+  double seconds = 0.0;
+  // Latencies in seconds, sorted
+  std::vector<double> latencies;
+
+  double Percentile(double fraction) const;
+};
+
+/**
+ * @brief Load generator: sends `requests` copies of the same request over
+ * `connections` concurrent connections and times every round trip.
+ *
+ */
+LoadSummary RunLoad(const std::string& path, std::span<const Point> points, RequestKind kind,
+                    size_t requests, size_t connections);
+
+}  // namespace cya
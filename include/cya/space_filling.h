@@ -0,0 +1,46 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo space_filling.h: Claves de curvas de Morton y Hilbert
+ * Referencias:
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "cya/point_types.h"
+#include "cya/radix_sort.h"
+
+namespace cya {
+
+enum Curve { MORTON, HILBERT };
+
+std::uint64_t MortonKey(std::uint32_t x, std::uint32_t y);
+std::uint64_t HilbertKey(std::uint32_t x, std::uint32_t y);
+
+Curve ParseCurve(const std::string& name);
+
+/**
+ * @brief Position of every point along the curve, as radix records whose
+ * index is the point index.
+ *
+ * Coordinates are quantized to 32 bits over the bounding box, with the same
+ * scale on both axes. Instantiated for Point, PointF and PointI.
+ */
+template <typename PointT>
+std::vector<RadixRecord> CurveKeys(std::span<const PointT> points, Curve curve);
+
+}  // namespace cya
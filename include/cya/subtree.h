@@ -1,12 +1,27 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
+#include "cya/flat_point_set.h"
 #include "cya/point_types.h"
 namespace cya {
 
-class SubTree {
+/**
+ * @brief Subtree of the EMST forest, generic over the point storage. The
+ * point type is the one the collection holds.
+ *
+ */
+template <typename Collection>
+class BasicSubTree {
  public:
-  SubTree() = default;
+  using PointT = typename Collection::value_type;
+  using Arc = std::pair<PointT, PointT>;
+  using WeightedArc = std::pair<double, Arc>;
+  using Tree = std::vector<Arc>;
+
+  BasicSubTree() = default;
 
   void AddArc(const Arc& arc, const double cost) {
     arcs_.emplace_back(arc);
@@ -14,11 +29,11 @@ class SubTree {
     points_.emplace(arc.second);
   }
 
-  void AddPoint(const Point& point) { points_.emplace(point); }
+  void AddPoint(const PointT& point) { points_.emplace(point); }
 
-  bool Contains(const Point& point) const { return points_.count(point); }
+  bool Contains(const PointT& point) const { return points_.count(point); }
 
-  void Merge(const SubTree& other, const WeightedArc& arc) {
+  void Merge(const BasicSubTree& other, const WeightedArc& arc) {
     arcs_.insert(arcs_.end(), other.GetArcs().begin(), other.GetArcs().end());
     arcs_.emplace_back(arc.second);
     points_.insert(other.GetPoints().begin(), other.GetPoints().end());
@@ -26,15 +41,17 @@ class SubTree {
   }
 
   inline const Tree& GetArcs() const { return arcs_; }
-  inline const PointCollection& GetPoints() const { return points_; }
+  inline const Collection& GetPoints() const { return points_; }
   inline double GetCost() const { return cost_; }
 
  private:
   Tree arcs_;
-  PointCollection points_;
-  double cost_;
+  Collection points_;
+  double cost_ = 0.0;
 };
 
+using SubTree = BasicSubTree<FlatPointSet>;
+using OrderedSubTree = BasicSubTree<PointCollection>;
 using SubTreeVector = std::vector<SubTree>;
 
-}  // namespace cya
\ No newline at end of file
+}  // namespace cya
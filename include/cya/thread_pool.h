@@ -0,0 +1,82 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo thread_pool.h: Conjunto fijo de hilos de trabajo
+ * Referencias:
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cya {
+
+/**
+ * @brief Fixed set of worker threads that run queued tasks in order of
+ * submission.
+ *
+ * Tasks must not throw; a task that needs to report an error keeps it itself.
+ * The destructor runs every queued task before joining the workers.
+ */
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Submit(std::function<void()> task);
+  // Blocks until every submitted task has finished
+  void Wait();
+
+  inline size_t size() const { return workers_.size(); }
+
+ private:
+  void Work();
+
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::deque<std::function<void()>> tasks_;
+  size_t running_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Counting semaphore over bytes, to bound the memory used by tasks
+ * that run at the same time.
+ *
+ * A request larger than the whole budget is granted once nothing else is
+ * held, so it runs alone instead of never.
+ */
+class MemoryBudget {
+ public:
+  explicit MemoryBudget(size_t bytes) : budget_(bytes) {}
+
+  void Acquire(size_t bytes);
+  void Release(size_t bytes);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  size_t budget_;
+  size_t used_ = 0;
+};
+
+}  // namespace cya
@@ -0,0 +1,164 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo batch.cc: Implementación del procesamiento por lotes
+ * Referencias:
+ */
+
+#include <glob.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include "cya/batch.h"
+#include "cya/parser.h"
+#include "cya/pointset.h"
+#include "cya/thread_pool.h"
+
+namespace cya {
+
+namespace {
+
+// Rough peak memory of a job per byte of input: the mapping, the parsed
+// points and the copies made by the hull engines
+constexpr size_t kMemoryPerInputByte = 4;
+
+bool IsGlobPattern(const std::string& source) {
+  return source.find_first_of("*?[") != std::string::npos;
+}
+
+std::vector<std::string> ExpandGlob(const std::string& pattern) {
+  glob_t matches{};
+  const int status = ::glob(pattern.c_str(), 0, nullptr, &matches);
+  if (status != 0) {
+    globfree(&matches);
+    if (status == GLOB_NOMATCH) {
+      throw std::runtime_error("No input matches " + pattern);
+    }
+    throw std::runtime_error("Could not expand " + pattern);
+  }
+  std::vector<std::string> inputs(matches.gl_pathv, matches.gl_pathv + matches.gl_pathc);
+  globfree(&matches);
+  return inputs;
+}
+
+std::vector<std::string> ReadManifest(const std::string& filename) {
+  std::ifstream manifest(filename);
+  if (!manifest) {
+    throw std::runtime_error("Could not open manifest " + filename);
+  }
+  std::vector<std::string> inputs;
+  std::string line;
+  while (std::getline(manifest, line)) {
+    const size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') {
+      continue;
+    }
+    const size_t last = line.find_last_not_of(" \t\r");
+    inputs.push_back(line.substr(first, last - first + 1));
+  }
+  return inputs;
+}
+
+// Name of the input without the compression and point file extensions
+std::string InputStem(const std::string& input) {
+  std::filesystem::path name = std::filesystem::path(input).filename();
+  if (name.extension() == ".gz" || name.extension() == ".zst") {
+    name = name.stem();
+  }
+  return name.has_extension() ? name.stem().string() : name.string();
+}
+
+}  // namespace
+
+std::vector<std::string> ExpandInputs(const std::string& source) {
+  std::vector<std::string> inputs = IsGlobPattern(source) ? ExpandGlob(source)
+                                                          : ReadManifest(source);
+  if (inputs.empty()) {
+    throw std::runtime_error("No input files in " + source);
+  }
+  return inputs;
+}
+
+std::vector<std::string> BatchOutputNames(const std::vector<std::string>& inputs,
+                                          const std::string& output_dir,
+                                          PointFormat format) {
+  const std::string extension = format == BINARY ? ".hull.bin" : ".hull.txt";
+  std::map<std::string, size_t> uses;
+  std::vector<std::string> outputs;
+  outputs.reserve(inputs.size());
+  for (const std::string& input : inputs) {
+    const std::string stem = InputStem(input);
+    const size_t use = ++uses[stem];
+    const std::string name = use == 1 ? stem : stem + "-" + std::to_string(use);
+    outputs.push_back((std::filesystem::path(output_dir) / (name + extension)).string());
+  }
+  return outputs;
+}
+
+BatchSummary RunBatch(const std::vector<std::string>& inputs,
+                      const std::vector<std::string>& outputs,
+                      const BatchOptions& options,
+                      std::ostream& errors) {
+  const auto start = std::chrono::steady_clock::now();
+  std::atomic<size_t> failed = 0;
+  std::atomic<size_t> points = 0;
+  std::mutex errors_mutex;
+  MemoryBudget budget(options.memory_budget);
+
+  {
+    ThreadPool pool(options.jobs);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      pool.Submit([&, i]() {
+        std::error_code error;
+        const size_t input_bytes = std::filesystem::file_size(inputs[i], error);
+        const size_t estimate = error ? 0 : input_bytes * kMemoryPerInputByte;
+        budget.Acquire(estimate);
+        try {
+          auto points_result = ParsePointsFromFile(inputs[i]);
+          if (!points_result) {
+            throw std::runtime_error(points_result.error().what());
+          }
+          points += points_result->size();
+          PointSet point_set(std::move(points_result).value());
+          if (options.improved) {
+            point_set.QuickHullImproved();
+          } else {
+            point_set.QuickHull();
+          }
+          point_set.Write(outputs[i], options.format);
+        } catch (const std::exception& e) {
+          ++failed;
+          std::lock_guard lock(errors_mutex);
+          errors << "Error in " << inputs[i] << ": " << e.what() << std::endl;
+        }
+        budget.Release(estimate);
+      });
+    }
+    pool.Wait();
+  }
+
+  BatchSummary summary;
+  summary.files = inputs.size();
+  summary.failed = failed;
+  summary.points = points;
+  summary.seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return summary;
+}
+
+}  // namespace cya
@@ -0,0 +1,211 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo binary_format.cc: Lectura y escritura del formato binario de puntos
+ * Referencias:
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "cya/binary_format.h"
+#include "cya/buffered_writer.h"
+
+namespace cya {
+
+namespace {
+
+template <typename T>
+void WriteLittleEndian(BufferedWriter& writer, T value) {
+  const auto bits = LittleEndian(value);
+  writer << std::string_view(reinterpret_cast<const char*>(&bits), sizeof(bits));
+}
+
+void WriteIndexHeader(BufferedWriter& writer, IndexKind kind, std::uint64_t count) {
+  writer << std::string_view(kIndexMagic, sizeof(kIndexMagic));
+  WriteLittleEndian(writer, kBinaryVersion);
+  writer << static_cast<char>(kind) << '\0';
+  WriteLittleEndian(writer, count);
+}
+
+/**
+ * @brief Rejects the points that INT32 cannot store exactly, before anything
+ * is written: fractional, out of range or not finite coordinates.
+ *
+ */
+void CheckCoordinates(std::span<const Point> points, CoordinateType type) {
+  if (type != INT32) {
+    return;
+  }
+  auto exact = [](double value) {
+    return value >= std::numeric_limits<std::int32_t>::min() &&
+           value <= std::numeric_limits<std::int32_t>::max() && std::trunc(value) == value;
+  };
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (!exact(points[i].x) || !exact(points[i].y)) {
+      throw std::runtime_error("Point " + std::to_string(i) + " (" + std::to_string(points[i].x) +
+                               ", " + std::to_string(points[i].y) +
+                               ") has coordinates that are not 32-bit integers");
+    }
+  }
+}
+
+void WriteCoordinate(BufferedWriter& writer, double value, CoordinateType type) {
+  if (type == FLOAT32) {
+    WriteLittleEndian(writer, std::bit_cast<std::uint32_t>(static_cast<float>(value)));
+  } else if (type == INT32) {
+    // Exact, see CheckCoordinates()
+    const auto integer = static_cast<std::int32_t>(value);
+    WriteLittleEndian(writer, std::bit_cast<std::uint32_t>(integer));
+  } else {
+    WriteLittleEndian(writer, std::bit_cast<std::uint64_t>(value));
+  }
+}
+
+}  // namespace
+
+std::optional<BinaryHeader> ReadBinaryHeader(std::string_view buffer) {
+  if (buffer.size() < kBinaryHeaderSize || !IsBinaryPoints(buffer)) {
+    return std::nullopt;
+  }
+
+  BinaryHeader header;
+  std::memcpy(&header.version, buffer.data() + 4, sizeof(header.version));
+  header.version = LittleEndian(header.version);
+  const auto type = static_cast<std::uint8_t>(buffer[6]);
+  const auto layout = static_cast<std::uint8_t>(buffer[7]);
+  std::memcpy(&header.count, buffer.data() + 8, sizeof(header.count));
+  header.count = LittleEndian(header.count);
+
+  if (header.version != kBinaryVersion || type > INT32 || layout > SOA) {
+    return std::nullopt;
+  }
+  header.coordinate_type = static_cast<CoordinateType>(type);
+  header.layout = static_cast<Layout>(layout);
+
+  const size_t payload = buffer.size() - kBinaryHeaderSize;
+  if (header.count > payload / (2 * CoordinateSize(header.coordinate_type))) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+void WriteBinaryPoints(const std::string& filename, std::span<const Point> points, Layout layout,
+                       CoordinateType type) {
+  CheckCoordinates(points, type);
+  BufferedWriter writer(filename);
+  WriteBinaryPoints(writer, points, layout, type);
+  writer.Close();
+}
+
+void WriteBinaryPoints(BufferedWriter& writer, std::span<const Point> points, Layout layout,
+                       CoordinateType type) {
+  CheckCoordinates(points, type);
+  writer << std::string_view(kBinaryMagic, sizeof(kBinaryMagic));
+  WriteLittleEndian(writer, kBinaryVersion);
+  writer << static_cast<char>(type) << static_cast<char>(layout);
+  WriteLittleEndian(writer, static_cast<std::uint64_t>(points.size()));
+
+  if (layout == SOA) {
+    for (const Point& point : points) {
+      WriteCoordinate(writer, point.x, type);
+    }
+    for (const Point& point : points) {
+      WriteCoordinate(writer, point.y, type);
+    }
+  } else {
+    for (const Point& point : points) {
+      WriteCoordinate(writer, point.x, type);
+      WriteCoordinate(writer, point.y, type);
+    }
+  }
+}
+
+void WriteTextPoints(const std::string& filename, std::span<const Point> points) {
+  BufferedWriter writer(filename);
+  writer << points.size() << '\n';
+  for (const Point& point : points) {
+    writer << point.x << ' ' << point.y << '\n';
+  }
+  writer.Close();
+}
+
+void WriteHullIndices(const std::string& filename, std::span<const PointIndex> hull) {
+  BufferedWriter writer(filename);
+  WriteHullIndices(writer, hull);
+  writer.Close();
+}
+
+void WriteTreeIndices(const std::string& filename, std::span<const IndexArc> tree) {
+  BufferedWriter writer(filename);
+  WriteTreeIndices(writer, tree);
+  writer.Close();
+}
+
+void WriteHullIndices(BufferedWriter& writer, std::span<const PointIndex> hull) {
+  WriteIndexHeader(writer, HULL_INDICES, hull.size());
+  for (const PointIndex index : hull) {
+    WriteLittleEndian(writer, index);
+  }
+}
+
+void WriteTreeIndices(BufferedWriter& writer, std::span<const IndexArc> tree) {
+  WriteIndexHeader(writer, TREE_INDICES, tree.size());
+  for (const auto& [from, to] : tree) {
+    WriteLittleEndian(writer, from);
+    WriteLittleEndian(writer, to);
+  }
+}
+
+std::optional<BinaryIndices> ReadBinaryIndices(std::string_view buffer) {
+  if constexpr (std::endian::native != std::endian::little) {
+    return std::nullopt;
+  }
+  if (buffer.size() < kBinaryHeaderSize ||
+      std::memcmp(buffer.data(), kIndexMagic, sizeof(kIndexMagic)) != 0) {
+    return std::nullopt;
+  }
+
+  std::uint16_t version;
+  std::memcpy(&version, buffer.data() + 4, sizeof(version));
+  const auto kind = static_cast<std::uint8_t>(buffer[6]);
+  BinaryIndices result;
+  std::memcpy(&result.count, buffer.data() + 8, sizeof(result.count));
+  const char* data = buffer.data() + kBinaryHeaderSize;
+  if (version != kBinaryVersion || kind > TREE_INDICES ||
+      reinterpret_cast<std::uintptr_t>(data) % alignof(PointIndex) != 0) {
+    return std::nullopt;
+  }
+  result.kind = static_cast<IndexKind>(kind);
+
+  const size_t per_entry = result.kind == TREE_INDICES ? 2 : 1;
+  const size_t available = (buffer.size() - kBinaryHeaderSize) / sizeof(PointIndex);
+  if (result.count > available / per_entry) {
+    return std::nullopt;
+  }
+  result.indices = {reinterpret_cast<const PointIndex*>(data), result.count * per_entry};
+  return result;
+}
+
+Layout ParseLayout(const std::string& name) {
+  if (name == "aos") {
+    return AOS;
+  }
+  if (name == "soa") {
+    return SOA;
+  }
+  throw std::runtime_error("Unknown layout: " + name + " (expected aos or soa)");
+}
+
+}  // namespace cya
@@ -0,0 +1,134 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo buffered_writer.cc: Implementación de la escritura con búfer
+ * Referencias:
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "cya/buffered_writer.h"
+#include "cya/mapped_file.h"
+
+namespace cya {
+
+BufferedWriter::BufferedWriter(const std::string& filename)
+    : filename_(filename), owned_(true), buffer_(kBufferSize) {
+  if (filename == kStandardStream) {
+    descriptor_ = STDOUT_FILENO;
+    owned_ = false;
+    return;
+  }
+  descriptor_ = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor_ == -1) {
+    throw std::runtime_error("Unable to open file: " + filename + " for writing.");
+  }
+}
+
+BufferedWriter::BufferedWriter(int descriptor) : descriptor_(descriptor), buffer_(kBufferSize) {}
+
+BufferedWriter::~BufferedWriter() {
+  // Errors can only be reported by an explicit Close()
+  try {
+    Close();
+  } catch (const std::exception& e) {
+  }
+}
+
+BufferedWriter& BufferedWriter::operator<<(std::string_view text) {
+  if (text.size() > buffer_.size()) {
+    Flush();
+    WriteAll(text.data(), text.size());
+    return *this;
+  }
+  Reserve(text.size());
+  std::memcpy(End(), text.data(), text.size());
+  used_ += text.size();
+  return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(char character) {
+  Reserve(1);
+  buffer_[used_++] = character;
+  return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(double value) {
+  // The longest shortest-representation double takes 24 characters
+  Reserve(32);
+  const auto [end, error] = std::to_chars(End(), buffer_.data() + buffer_.size(), value);
+  used_ = end - buffer_.data();
+  return *this;
+}
+
+BufferedWriter& BufferedWriter::operator<<(float value) {
+  // Shortest representation that reads back to the same float, not double
+  Reserve(32);
+  const auto [end, error] = std::to_chars(End(), buffer_.data() + buffer_.size(), value);
+  used_ = end - buffer_.data();
+  return *this;
+}
+
+BufferedWriter& BufferedWriter::WriteFixed(double value, int precision) {
+  Reserve(std::numeric_limits<double>::max_exponent10 + precision + 8);
+  const auto [end, error] = std::to_chars(
+      End(), buffer_.data() + buffer_.size(), value, std::chars_format::fixed, precision);
+  used_ = end - buffer_.data();
+  return *this;
+}
+
+void BufferedWriter::Flush() {
+  const size_t used = std::exchange(used_, 0);
+  WriteAll(buffer_.data(), used);
+}
+
+void BufferedWriter::WriteAll(const char* data, size_t size) {
+  size_t remaining = size;
+  while (remaining > 0) {
+    const ssize_t written = ::write(descriptor_, data, remaining);
+    if (written == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Error occurred while writing to file: " + filename_ + ": " +
+                               std::strerror(errno));
+    }
+    data += written;
+    remaining -= written;
+  }
+}
+
+void BufferedWriter::Close() {
+  if (descriptor_ == -1) {
+    return;
+  }
+  Flush();
+  if (owned_ && ::close(descriptor_) == -1) {
+    descriptor_ = -1;
+    throw std::runtime_error("Error occurred while writing to file: " + filename_);
+  }
+  descriptor_ = -1;
+}
+
+void BufferedWriter::Reserve(size_t bytes) {
+  if (used_ + bytes > buffer_.size()) {
+    Flush();
+  }
+}
+
+}  // namespace cya
@@ -0,0 +1,197 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo clustering.cc: Clustering single-linkage a partir del EMST
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "cya/buffered_writer.h"
+#include "cya/clustering.h"
+#include "cya/pointset.h"
+
+namespace cya {
+
+/**
+ * @brief Cuts the EMST at a distance: points joined by arcs no longer than
+ * `threshold` share a cluster.
+ *
+ */
+template <typename PointT>
+ClusterLabels BasicPointSet<PointT>::ClusterByDistance(double threshold) const {
+  std::vector<std::pair<double, IndexArc>> arcs;
+  LinkageOrder(arcs);
+  DisjointSet components(size());
+  for (const auto& [distance, arc] : arcs) {
+    if (distance > threshold) {
+      break;
+    }
+    components.Union(arc.first, arc.second);
+  }
+  return LabelComponents(components);
+}
+
+/**
+ * @brief Cuts the EMST into `clusters` clusters by dropping its longest arcs.
+ *
+ */
+template <typename PointT>
+ClusterLabels BasicPointSet<PointT>::ClusterByCount(size_t clusters) const {
+  std::vector<std::pair<double, IndexArc>> arcs;
+  LinkageOrder(arcs);
+  DisjointSet components(size());
+  clusters = std::max<size_t>(clusters, 1);
+  for (const auto& [distance, arc] : arcs) {
+    if (components.GetComponentCount() <= clusters) {
+      break;
+    }
+    components.Union(arc.first, arc.second);
+  }
+  return LabelComponents(components);
+}
+
+/**
+ * @brief Full single-linkage dendrogram in O(n log n) from the EMST.
+ *
+ */
+template <typename PointT>
+Dendrogram BasicPointSet<PointT>::ComputeDendrogram() const {
+  std::vector<std::pair<double, IndexArc>> arcs;
+  LinkageOrder(arcs);
+
+  const size_t n = size();
+  DisjointSet components(n);
+  std::vector<size_t> cluster_ids(n);
+  for (size_t i = 0; i < n; ++i) {
+    cluster_ids[i] = GetOriginalIndex(i);
+  }
+
+  Dendrogram dendrogram;
+  dendrogram.reserve(n > 0 ? n - 1 : 0);
+  for (const auto& [distance, arc] : arcs) {
+    const PointIndex first_root = components.Find(arc.first);
+    const PointIndex second_root = components.Find(arc.second);
+    if (!components.Union(first_root, second_root)) {
+      continue;
+    }
+    const PointIndex root = components.Find(first_root);
+    const size_t left = cluster_ids[first_root];
+    const size_t right = cluster_ids[second_root];
+    dendrogram.push_back({std::min(left, right),
+                          std::max(left, right),
+                          distance,
+                          components.GetComponentSize(root)});
+    cluster_ids[root] = n + dendrogram.size() - 1;
+  }
+  return dendrogram;
+}
+
+/**
+ * @brief Arcs of the EMST sorted by length.
+ *
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::LinkageOrder(std::vector<std::pair<double, IndexArc>>& arcs) const {
+  if (size() > 1 && tree_.empty()) {
+    throw std::runtime_error("The EMST must be computed before clustering.");
+  }
+
+  arcs.clear();
+  arcs.reserve(tree_.size());
+  for (const IndexArc& arc : tree_) {
+    arcs.emplace_back(std::sqrt(SquaredDistance((*this)[arc.first], (*this)[arc.second])), arc);
+  }
+  std::sort(arcs.begin(), arcs.end());
+}
+
+/**
+ * @brief Labels indexed by original point index, numbered in input order.
+ *
+ */
+template <typename PointT>
+ClusterLabels BasicPointSet<PointT>::LabelComponents(DisjointSet& components) const {
+  const std::vector<PointIndex> input_order = InputOrder();
+  ClusterLabels labels(size());
+  std::vector<int> root_labels(size(), -1);
+  int next_label = 0;
+  for (size_t original = 0; original < size(); ++original) {
+    int& label = root_labels[components.Find(input_order[original])];
+    if (label == -1) {
+      label = next_label++;
+    }
+    labels[original] = label;
+  }
+  return labels;
+}
+
+/**
+ * @brief Current index of every point, by original index.
+ *
+ */
+template <typename PointT>
+std::vector<PointIndex> BasicPointSet<PointT>::InputOrder() const {
+  std::vector<PointIndex> input_order(size());
+  for (size_t i = 0; i < size(); ++i) {
+    input_order[GetOriginalIndex(i)] = i;
+  }
+  return input_order;
+}
+
+template <typename PointT>
+void BasicPointSet<PointT>::WriteClusters(const std::string& filename,
+                                          const ClusterLabels& labels) const {
+  BufferedWriter writer(filename);
+  const std::vector<PointIndex> input_order = InputOrder();
+  for (size_t original = 0; original < size(); ++original) {
+    const PointT& point = (*this)[input_order[original]];
+    writer << '(' << point.x << ", " << point.y << ") " << labels[original] << '\n';
+  }
+  writer.Close();
+}
+
+template <typename PointT>
+void BasicPointSet<PointT>::WriteDendrogram(const std::string& filename,
+                                            const Dendrogram& dendrogram) const {
+  BufferedWriter writer(filename);
+  for (const DendrogramMerge& merge : dendrogram) {
+    writer << merge.left << ' ' << merge.right << ' ' << merge.distance << ' ' << merge.size
+           << '\n';
+  }
+  writer.Close();
+}
+
+// The members above are instantiated here, the rest of BasicPointSet in
+// poinset.cc
+#define CYA_INSTANTIATE_CLUSTERING(PointT)                                                      \
+  template ClusterLabels BasicPointSet<PointT>::ClusterByDistance(double) const;                \
+  template ClusterLabels BasicPointSet<PointT>::ClusterByCount(size_t) const;                   \
+  template Dendrogram BasicPointSet<PointT>::ComputeDendrogram() const;                         \
+  template void BasicPointSet<PointT>::LinkageOrder(std::vector<std::pair<double, IndexArc>>&)  \
+      const;                                                                                    \
+  template ClusterLabels BasicPointSet<PointT>::LabelComponents(DisjointSet&) const;            \
+  template std::vector<PointIndex> BasicPointSet<PointT>::InputOrder() const;                   \
+  template void BasicPointSet<PointT>::WriteClusters(const std::string&, const ClusterLabels&)  \
+      const;                                                                                    \
+  template void BasicPointSet<PointT>::WriteDendrogram(const std::string&, const Dendrogram&)   \
+      const;
+
+CYA_INSTANTIATE_CLUSTERING(Point)
+CYA_INSTANTIATE_CLUSTERING(PointF)
+CYA_INSTANTIATE_CLUSTERING(PointI)
+
+#undef CYA_INSTANTIATE_CLUSTERING
+
+}  // namespace cya
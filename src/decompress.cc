@@ -0,0 +1,204 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo decompress.cc: Implementación de la descompresión en segundo plano
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#ifdef CYA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CYA_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "cya/decompress.h"
+
+namespace cya {
+
+namespace {
+
+template <typename Sink>
+void Inflate([[maybe_unused]] std::string_view input, [[maybe_unused]] Sink&& sink) {
+#ifdef CYA_HAVE_ZLIB
+  z_stream stream{};
+  // 15 window bits plus 32 detects the gzip header automatically
+  if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+    throw std::runtime_error("Could not initialize gzip decompression");
+  }
+
+  // avail_in is 32 bits wide, so larger inputs are handed over in pieces
+  auto refill = [&]() {
+    const size_t piece = std::min<size_t>(input.size(), std::numeric_limits<uInt>::max());
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(piece);
+    input.remove_prefix(piece);
+  };
+  refill();
+  std::string block(DecompressStream::kBlockSize, '\0');
+  size_t filled = 0;
+  int status = Z_OK;
+  while (true) {
+    stream.next_out = reinterpret_cast<Bytef*>(block.data() + filled);
+    stream.avail_out = static_cast<uInt>(block.size() - filled);
+    status = inflate(&stream, Z_NO_FLUSH);
+    filled = block.size() - stream.avail_out;
+    if (stream.avail_in == 0 && !input.empty()) {
+      refill();
+    }
+
+    // Concatenated gzip members decompress to the concatenated data
+    if (status == Z_STREAM_END && stream.avail_in > 0) {
+      status = inflateReset(&stream);
+    }
+    if (status != Z_OK && status != Z_STREAM_END) {
+      inflateEnd(&stream);
+      throw std::runtime_error("Corrupt gzip input");
+    }
+    if (filled == block.size() || status == Z_STREAM_END) {
+      block.resize(filled);
+      if (!sink(std::move(block)) || status == Z_STREAM_END) {
+        break;
+      }
+      block.assign(DecompressStream::kBlockSize, '\0');
+      filled = 0;
+    } else if (stream.avail_in == 0) {
+      inflateEnd(&stream);
+      throw std::runtime_error("Truncated gzip input");
+    }
+  }
+  inflateEnd(&stream);
+#else
+  throw std::runtime_error("gzip input is not supported: cya was built without zlib");
+#endif
+}
+
+template <typename Sink>
+void Unzstd([[maybe_unused]] std::string_view input, [[maybe_unused]] Sink&& sink) {
+#ifdef CYA_HAVE_ZSTD
+  ZSTD_DStream* stream = ZSTD_createDStream();
+  if (stream == nullptr) {
+    throw std::runtime_error("Could not initialize zstd decompression");
+  }
+  ZSTD_initDStream(stream);
+
+  ZSTD_inBuffer in{input.data(), input.size(), 0};
+  std::string block(DecompressStream::kBlockSize, '\0');
+  ZSTD_outBuffer out{block.data(), block.size(), 0};
+  size_t status = 0;
+  while (true) {
+    status = ZSTD_decompressStream(stream, &out, &in);
+    if (ZSTD_isError(status)) {
+      ZSTD_freeDStream(stream);
+      throw std::runtime_error(std::string("Corrupt zstd input: ") + ZSTD_getErrorName(status));
+    }
+    const bool finished = in.pos == in.size && out.pos < out.size;
+    if (out.pos == out.size || finished) {
+      block.resize(out.pos);
+      if (!sink(std::move(block)) || finished) {
+        break;
+      }
+      block.assign(DecompressStream::kBlockSize, '\0');
+      out = {block.data(), block.size(), 0};
+    }
+  }
+  ZSTD_freeDStream(stream);
+  // A non-zero status at the end means the last frame was cut short
+  if (status != 0) {
+    throw std::runtime_error("Truncated zstd input");
+  }
+#else
+  throw std::runtime_error("zstd input is not supported: cya was built without zstd");
+#endif
+}
+
+}  // namespace
+
+Compression DetectCompression(std::string_view buffer) {
+  if (buffer.starts_with("\x1f\x8b")) {
+    return GZIP;
+  }
+  if (buffer.starts_with("\x28\xb5\x2f\xfd")) {
+    return ZSTD;
+  }
+  return NONE;
+}
+
+DecompressStream::DecompressStream(std::string_view input, Compression compression)
+    : worker_(&DecompressStream::Run, this, input, compression) {}
+
+DecompressStream::~DecompressStream() {
+  {
+    std::lock_guard lock(mutex_);
+    cancelled_ = true;
+  }
+  changed_.notify_all();
+  worker_.join();
+}
+
+std::optional<std::string> DecompressStream::Next() {
+  std::unique_lock lock(mutex_);
+  changed_.wait(lock, [this] { return !blocks_.empty() || finished_; });
+  if (!blocks_.empty()) {
+    std::string block = std::move(blocks_.front());
+    blocks_.pop_front();
+    lock.unlock();
+    changed_.notify_all();
+    return block;
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return std::nullopt;
+}
+
+void DecompressStream::Run(std::string_view input, Compression compression) {
+  auto sink = [this](std::string block) { return Push(std::move(block)); };
+  std::exception_ptr error;
+  try {
+    if (compression == GZIP) {
+      Inflate(input, sink);
+    } else if (compression == ZSTD) {
+      Unzstd(input, sink);
+    } else {
+      sink(std::string(input));
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard lock(mutex_);
+    error_ = error;
+    finished_ = true;
+  }
+  changed_.notify_all();
+}
+
+bool DecompressStream::Push(std::string block) {
+  std::unique_lock lock(mutex_);
+  changed_.wait(lock, [this] { return blocks_.size() < kMaxQueuedBlocks || cancelled_; });
+  if (cancelled_) {
+    return false;
+  }
+  blocks_.push_back(std::move(block));
+  lock.unlock();
+  changed_.notify_all();
+  return true;
+}
+
+}  // namespace cya
@@ -0,0 +1,158 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo graph_writer.cc: Implementación de la escritura de grafos
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include "cya/graph_writer.h"
+
+namespace cya {
+
+// Longest side of the SVG image in pixels
+constexpr double kSvgSize = 1000.0;
+
+template <typename PointT>
+BasicGraphWriter<PointT>::BasicGraphWriter(const std::string& filename, GraphFormat format,
+                                           std::span<const PointT> points)
+    : format_(format), points_(points), writer_(filename) {
+  if (format_ == DOT) {
+    // Start dot graph with minimalist styling
+    writer_ << "graph G {\n"
+            << "  layout=neato;\n"
+            << "  overlap=false;\n"
+            << "  bgcolor=white;\n"
+            << "  node [style=filled, color=black, fillcolor=black, width=0.05, height=0.05, "
+               "shape=point];\n";
+    return;
+  }
+
+  Point min{0.0, 0.0};
+  Point max{0.0, 0.0};
+  if (!points_.empty()) {
+    min = max = {static_cast<double>(points_.front().x), static_cast<double>(points_.front().y)};
+    for (const PointT& point : points_) {
+      min = {std::min<double>(min.x, point.x), std::min<double>(min.y, point.y)};
+      max = {std::max<double>(max.x, point.x), std::max<double>(max.y, point.y)};
+    }
+  }
+  const double margin = std::max({max.x - min.x, max.y - min.y, 1.0}) * 0.02;
+  const double width = max.x - min.x + 2 * margin;
+  const double height = max.y - min.y + 2 * margin;
+  const double scale = kSvgSize / std::max(width, height);
+  // Enough decimals to place points within a tenth of a pixel
+  precision_ = std::clamp(static_cast<int>(std::ceil(std::log10(10.0 * scale))), 0, 17);
+
+  // The y axis is flipped by negating every y coordinate
+  writer_ << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << std::ceil(width * scale)
+          << "\" height=\"" << std::ceil(height * scale) << "\" viewBox=\"" << min.x - margin
+          << ' ' << -max.y - margin << ' ' << width << ' ' << height << "\">\n"
+          << "<rect x=\"" << min.x - margin << "\" y=\"" << -max.y - margin << "\" width=\""
+          << width << "\" height=\"" << height << "\" fill=\"white\"/>\n";
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::WriteNodes() {
+  std::vector<PointIndex> indices(points_.size());
+  std::iota(indices.begin(), indices.end(), PointIndex{0});
+  WriteNodes(indices);
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::WriteNodes(std::span<const PointIndex> indices) {
+  if (format_ == DOT) {
+    for (const PointIndex index : indices) {
+      WriteNode(index);
+    }
+    return;
+  }
+
+  // A zero-length segment with round caps draws a dot
+  writer_ << "<path fill=\"none\" stroke=\"black\" stroke-width=\"3\" stroke-linecap=\"round\" "
+             "vector-effect=\"non-scaling-stroke\" d=\"";
+  for (const PointIndex index : indices) {
+    WriteNode(index);
+  }
+  writer_ << "\"/>\n";
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::BeginEdges(std::string_view color, double width) {
+  if (format_ == DOT) {
+    writer_ << "  edge [color=\"" << color << "\", penwidth=" << width << "];\n";
+    return;
+  }
+  writer_ << "<path fill=\"none\" stroke=\"" << color << "\" stroke-width=\"" << width
+          << "\" vector-effect=\"non-scaling-stroke\" d=\"";
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::WriteEdge(PointIndex from, PointIndex to) {
+  if (format_ == DOT) {
+    writer_ << "  " << from << " -- " << to << ";\n";
+    return;
+  }
+  writer_ << 'M';
+  WriteCoordinates(points_[from]);
+  writer_ << 'L';
+  WriteCoordinates(points_[to]);
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::EndEdges() {
+  if (format_ == SVG) {
+    writer_ << "\"/>\n";
+  }
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::Close() {
+  writer_ << (format_ == DOT ? "}\n" : "</svg>\n");
+  writer_.Close();
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::WriteNode(PointIndex index) {
+  if (format_ == DOT) {
+    writer_ << "  " << index << " [pos=\"";
+    WriteCoordinates(points_[index]);
+    writer_ << "!\"];\n";
+    return;
+  }
+  writer_ << 'M';
+  WriteCoordinates(points_[index]);
+  writer_ << "h0";
+}
+
+template <typename PointT>
+void BasicGraphWriter<PointT>::WriteCoordinates(const PointT& point) {
+  const double x = point.x;
+  const double y = point.y;
+  if (format_ == DOT) {
+    writer_.WriteFixed(x, 2) << ',';
+    writer_.WriteFixed(y, 2);
+    return;
+  }
+  writer_.WriteFixed(x, precision_) << ' ';
+  writer_.WriteFixed(-y, precision_);
+}
+
+template class BasicGraphWriter<Point>;
+template class BasicGraphWriter<PointF>;
+template class BasicGraphWriter<PointI>;
+
+}  // namespace cya
@@ -0,0 +1,270 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo grid.cc: Implementación del índice espacial de rejilla uniforme
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "cya/grid.h"
+#include "cya/parallel.h"
+
+namespace cya {
+
+namespace {
+
+template <typename PointT>
+inline double SquaredDistance(const PointT& a, const PointT& b) {
+  const double dx = static_cast<double>(a.x) - b.x;
+  const double dy = static_cast<double>(a.y) - b.y;
+  return dx * dx + dy * dy;
+}
+
+}  // namespace
+
+/**
+ * @brief Builds the grid with a parallel counting sort of the points by cell.
+ *
+ */
+template <typename PointT>
+BasicUniformGrid<PointT>::BasicUniformGrid(std::span<const PointT> points,
+                                           double points_per_cell) {
+  const size_t n = points.size();
+  if (n == 0) {
+    cell_start_.assign(1, 0);
+    return;
+  }
+
+  PointT min = points[0];
+  PointT max = points[0];
+  for (const PointT& point : points) {
+    min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+    max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+  }
+  const double width = static_cast<double>(max.x) - min.x;
+  const double height = static_cast<double>(max.y) - min.y;
+
+  // Cell side so that a cell holds `points_per_cell` points on average. The
+  // second bound keeps thin bounding boxes from exploding into O(n²) cells:
+  // there are never more than 2n / points_per_cell + 1 of them
+  cell_size_ = std::max(std::sqrt(width * height * points_per_cell / n),
+                        (width + height) * points_per_cell / n);
+  if (cell_size_ <= 0) {
+    cell_size_ = 1.0;
+  }
+  inverse_cell_size_ = 1.0 / cell_size_;
+  origin_ = {static_cast<double>(min.x), static_cast<double>(min.y)};
+  columns_ = static_cast<size_t>(width * inverse_cell_size_) + 1;
+  rows_ = static_cast<size_t>(height * inverse_cell_size_) + 1;
+  const size_t cells = columns_ * rows_;
+
+  std::vector<PointIndex> cell_of(n);
+  std::vector<std::atomic<PointIndex>> counts(cells);
+  ParallelChunks(n, ParallelChunkCount(n), [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      cell_of[i] = Row(points[i].y) * columns_ + Column(points[i].x);
+      counts[cell_of[i]].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  cell_start_.assign(cells + 1, 0);
+  std::transform_inclusive_scan(
+      counts.begin(), counts.end(), cell_start_.begin() + 1, std::plus<>(), [](const auto& c) {
+        return c.load(std::memory_order_relaxed);
+      });
+
+  std::vector<std::atomic<PointIndex>> cursor(cells);
+  for (size_t cell = 0; cell < cells; ++cell) {
+    cursor[cell].store(cell_start_[cell], std::memory_order_relaxed);
+  }
+  indices_.resize(n);
+  ParallelChunks(n, ParallelChunkCount(n), [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      indices_[cursor[cell_of[i]].fetch_add(1, std::memory_order_relaxed)] = i;
+    }
+  });
+
+  // Chunks race inside a bucket; sorting the small buckets keeps the layout
+  // deterministic
+  ParallelChunks(cells, ParallelChunkCount(cells), [&](size_t, size_t begin, size_t end) {
+    for (size_t cell = begin; cell < end; ++cell) {
+      std::sort(indices_.begin() + cell_start_[cell], indices_.begin() + cell_start_[cell + 1]);
+    }
+  });
+
+  points_.resize(n);
+  ParallelFor(n, [&](size_t i) { points_[i] = points[indices_[i]]; });
+}
+
+template <typename PointT>
+PointIndex BasicUniformGrid<PointT>::Nearest(const PointT& query) const {
+  if (points_.empty()) {
+    throw std::runtime_error("Nearest neighbor query on an empty grid.");
+  }
+  std::vector<Neighbor> result;
+  KNearest(query, 1, result);
+  return result.front().second;
+}
+
+/**
+ * @brief The k nearest points, sorted by distance.
+ *
+ * Rings of cells at growing Chebyshev distance from the query cell are
+ * visited until the k-th best distance is closer than anything outside the
+ * visited square.
+ */
+template <typename PointT>
+void BasicUniformGrid<PointT>::KNearest(const PointT& query, size_t k,
+                                        std::vector<Neighbor>& result) const {
+  result.clear();
+  k = std::min(k, points_.size());
+  if (k == 0) {
+    return;
+  }
+
+  const long column = Column(query.x);
+  const long row = Row(query.y);
+  const long max_ring = std::max<long>({column, row, long(columns_) - 1 - column,
+                                        long(rows_) - 1 - row});
+  const double infinity = std::numeric_limits<double>::infinity();
+
+  for (long ring = 0; ring <= max_ring; ++ring) {
+    const long left = column - ring;
+    const long right = column + ring;
+    const long bottom = row - ring;
+    const long top = row + ring;
+    for (long r = std::max(bottom, 0l); r <= std::min(top, long(rows_) - 1); ++r) {
+      const bool edge_row = r == bottom || r == top;
+      for (long c = std::max(left, 0l); c <= std::min(right, long(columns_) - 1); ++c) {
+        if (edge_row || c == left || c == right) {
+          Offer(r * columns_ + c, query, k, result);
+        }
+      }
+    }
+
+    if (result.size() == k) {
+      // Closest distance from the query to a cell outside the visited square
+      double gap = infinity;
+      if (left > 0) {
+        gap = std::min(gap, query.x - (origin_.x + left * cell_size_));
+      }
+      if (right < long(columns_) - 1) {
+        gap = std::min(gap, origin_.x + (right + 1) * cell_size_ - query.x);
+      }
+      if (bottom > 0) {
+        gap = std::min(gap, query.y - (origin_.y + bottom * cell_size_));
+      }
+      if (top < long(rows_) - 1) {
+        gap = std::min(gap, origin_.y + (top + 1) * cell_size_ - query.y);
+      }
+      if (gap >= 0 && gap * gap >= result.front().first) {
+        break;
+      }
+    }
+  }
+  std::sort_heap(result.begin(), result.end());
+}
+
+template <typename PointT>
+void BasicUniformGrid<PointT>::Radius(const PointT& query, double radius,
+                                      std::vector<PointIndex>& result) const {
+  result.clear();
+  if (points_.empty()) {
+    return;
+  }
+  const double radius2 = radius * radius;
+  const size_t first_column = Column(query.x - radius);
+  const size_t last_column = Column(query.x + radius);
+  const size_t first_row = Row(query.y - radius);
+  const size_t last_row = Row(query.y + radius);
+  for (size_t r = first_row; r <= last_row; ++r) {
+    for (size_t c = first_column; c <= last_column; ++c) {
+      const size_t cell = r * columns_ + c;
+      for (size_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+        if (SquaredDistance(query, points_[i]) <= radius2) {
+          result.push_back(indices_[i]);
+        }
+      }
+    }
+  }
+}
+
+template <typename PointT>
+std::vector<PointIndex> BasicUniformGrid<PointT>::Nearest(const PointVector& queries) const {
+  std::vector<PointIndex> result(queries.size());
+  ParallelFor(
+      queries.size(), [&](size_t q) { result[q] = Nearest(queries[q]); }, kQueryGrain);
+  return result;
+}
+
+/**
+ * @brief Batched k-NN: the neighbors of query q are at [q * k', (q + 1) * k'),
+ * with k' = min(k, size()).
+ */
+template <typename PointT>
+std::vector<PointIndex> BasicUniformGrid<PointT>::KNearest(const PointVector& queries,
+                                                           size_t k) const {
+  k = std::min(k, size());
+  std::vector<PointIndex> result(queries.size() * k);
+  ParallelFor(
+      queries.size(),
+      [&](size_t q) {
+        thread_local std::vector<Neighbor> neighbors;
+        KNearest(queries[q], k, neighbors);
+        for (size_t t = 0; t < k; ++t) {
+          result[q * k + t] = neighbors[t].second;
+        }
+      },
+      kQueryGrain);
+  return result;
+}
+
+// Queries outside the bounding box are clamped to the border cells
+template <typename PointT>
+size_t BasicUniformGrid<PointT>::Column(double x) const {
+  const double column = std::floor((x - origin_.x) * inverse_cell_size_);
+  return std::clamp(column, 0.0, double(columns_ - 1));
+}
+
+template <typename PointT>
+size_t BasicUniformGrid<PointT>::Row(double y) const {
+  const double row = std::floor((y - origin_.y) * inverse_cell_size_);
+  return std::clamp(row, 0.0, double(rows_ - 1));
+}
+
+template <typename PointT>
+void BasicUniformGrid<PointT>::Offer(size_t cell, const PointT& query, size_t k,
+                                     std::vector<Neighbor>& heap) const {
+  for (size_t i = cell_start_[cell]; i < cell_start_[cell + 1]; ++i) {
+    const double dist = SquaredDistance(query, points_[i]);
+    if (heap.size() < k) {
+      heap.emplace_back(dist, indices_[i]);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (dist < heap.front().first) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = {dist, indices_[i]};
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+}
+
+template class BasicUniformGrid<Point>;
+template class BasicUniformGrid<PointF>;
+template class BasicUniformGrid<PointI>;
+
+}  // namespace cya
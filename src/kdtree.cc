@@ -0,0 +1,457 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo kdtree.cc: Implementación del índice espacial k-d tree
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "cya/kdtree.h"
+#include "cya/parallel.h"
+
+namespace cya {
+
+namespace {
+
+template <typename PointT>
+inline double Coordinate(const PointT& point, std::uint32_t axis) {
+  return axis == 0 ? point.x : point.y;
+}
+
+template <typename PointT>
+inline double SquaredDistance(const PointT& a, const PointT& b) {
+  const double dx = static_cast<double>(a.x) - b.x;
+  const double dy = static_cast<double>(a.y) - b.y;
+  return dx * dx + dy * dy;
+}
+
+// Whether a point of the box [low, high], given as offsets from the query,
+// could improve the best neighbor of one of the octants the box overlaps. The
+// distance from the query to the whole box bounds the one to every part; a
+// point at the best distance may still win the tie by index.
+inline bool MayImproveOctant(double low_x, double high_x, double low_y, double high_y,
+                             const OctantNeighbors& best) {
+  const double gap_x = std::max({0.0, low_x, -high_x});
+  const double gap_y = std::max({0.0, low_y, -high_y});
+  const double dist = gap_x * gap_x + gap_y * gap_y;
+  // The box may hold a duplicate of the query
+  if (dist == 0) {
+    return true;
+  }
+  for (size_t down = 0; down < 2; ++down) {
+    // Distances to the x axis of the part of the box in this half plane
+    const double far_y = down ? -low_y : high_y;
+    const double near_y = std::max(0.0, down ? -high_y : low_y);
+    if (far_y < 0) {
+      continue;
+    }
+    for (size_t left = 0; left < 2; ++left) {
+      const double far_x = left ? -low_x : high_x;
+      const double near_x = std::max(0.0, left ? -high_x : low_x);
+      if (far_x < 0) {
+        continue;
+      }
+      const size_t octant = down << 2 | left << 1;
+      if (far_x >= near_y && dist <= best[octant].first) {
+        return true;
+      }
+      if (far_y >= near_x && dist <= best[octant | 1].first) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+/**
+ * @brief Builds the tree in parallel.
+ *
+ * The top levels are split level by level, the nodes of a level at the same
+ * time, until there is a subtree per thread; the subtrees are then built
+ * concurrently.
+ */
+template <typename PointT>
+BasicKdTree<PointT>::BasicKdTree(std::span<const PointT> points, PointIndex offset)
+    : offset_(offset) {
+  entries_.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    entries_[i] = {points[i], PointIndex(offset + i), 0};
+  }
+
+  std::vector<std::pair<size_t, size_t>> frontier{{0, entries_.size()}};
+  const size_t subtrees = ParallelChunkCount(entries_.size());
+  bool split = true;
+  while (frontier.size() < subtrees && split) {
+    std::vector<size_t> mids(frontier.size(), 0);
+    ParallelChunks(frontier.size(), frontier.size(), [&](size_t chunk, size_t, size_t) {
+      const auto [low, high] = frontier[chunk];
+      if (high - low > kLeafSize) {
+        mids[chunk] = Partition(low, high);
+      }
+    });
+    split = false;
+    std::vector<std::pair<size_t, size_t>> next;
+    for (size_t i = 0; i < frontier.size(); ++i) {
+      const auto [low, high] = frontier[i];
+      if (high - low <= kLeafSize) {
+        next.emplace_back(low, high);
+        continue;
+      }
+      next.emplace_back(low, mids[i]);
+      next.emplace_back(mids[i] + 1, high);
+      split = true;
+    }
+    frontier = std::move(next);
+  }
+
+  ParallelChunks(frontier.size(), frontier.size(), [&](size_t chunk, size_t, size_t) {
+    Build(frontier[chunk].first, frontier[chunk].second);
+  });
+
+  if (!points.empty()) {
+    min_ = max_ = points.front();
+  }
+  for (const PointT& point : points) {
+    min_ = {std::min(min_.x, point.x), std::min(min_.y, point.y)};
+    max_ = {std::max(max_.x, point.x), std::max(max_.y, point.y)};
+  }
+}
+
+/**
+ * @brief Splits [low, high) at its median along the widest axis.
+ *
+ * @return Position of the node.
+ */
+template <typename PointT>
+size_t BasicKdTree<PointT>::Partition(size_t low, size_t high) {
+  PointT min = entries_[low].point;
+  PointT max = entries_[low].point;
+  for (size_t i = low + 1; i < high; ++i) {
+    const PointT& point = entries_[i].point;
+    min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+    max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+  }
+  // Integer extents can overflow, so they are compared in double
+  const double width = static_cast<double>(max.x) - min.x;
+  const double height = static_cast<double>(max.y) - min.y;
+  const std::uint32_t axis = height > width ? 1 : 0;
+
+  const size_t mid = low + (high - low) / 2;
+  auto by_axis = [axis](const Entry& a, const Entry& b) {
+    return Coordinate(a.point, axis) < Coordinate(b.point, axis);
+  };
+  std::nth_element(
+      entries_.begin() + low, entries_.begin() + mid, entries_.begin() + high, by_axis);
+  entries_[mid].axis = axis;
+  return mid;
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::Build(size_t low, size_t high) {
+  if (high - low <= kLeafSize) {
+    return;
+  }
+  const size_t mid = Partition(low, high);
+  Build(low, mid);
+  Build(mid + 1, high);
+}
+
+template <typename PointT>
+PointIndex BasicKdTree<PointT>::Nearest(const PointT& query) const {
+  if (entries_.empty()) {
+    throw std::runtime_error("Nearest neighbor query on an empty k-d tree.");
+  }
+  std::vector<Neighbor> heap;
+  SearchKNearest(0, entries_.size(), query, 1, heap);
+  return heap.front().second;
+}
+
+/**
+ * @brief The k nearest points, sorted by distance.
+ *
+ */
+template <typename PointT>
+void BasicKdTree<PointT>::KNearest(const PointT& query,
+                                   size_t k,
+                                   std::vector<Neighbor>& result) const {
+  result.clear();
+  AccumulateKNearest(query, k, result);
+  std::sort_heap(result.begin(), result.end());
+}
+
+/**
+ * @brief Offers the points of this tree to a max-heap of the k best
+ * neighbors, so several trees can contribute to one query.
+ *
+ */
+template <typename PointT>
+void BasicKdTree<PointT>::AccumulateKNearest(const PointT& query,
+                                             size_t k,
+                                             std::vector<Neighbor>& heap) const {
+  if (k == 0) {
+    return;
+  }
+  SearchKNearest(0, entries_.size(), query, k, heap);
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::Radius(const PointT& query,
+                                 double radius,
+                                 std::vector<PointIndex>& result) const {
+  result.clear();
+  SearchRadius(0, entries_.size(), query, radius * radius, result);
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::Rectangle(const PointT& low,
+                                    const PointT& high,
+                                    std::vector<PointIndex>& result) const {
+  result.clear();
+  SearchRectangle(0, entries_.size(), low, high, result);
+}
+
+template <typename PointT>
+std::vector<PointIndex> BasicKdTree<PointT>::Nearest(const PointVector& queries) const {
+  std::vector<PointIndex> result(queries.size());
+  ParallelFor(
+      queries.size(), [&](size_t q) { result[q] = Nearest(queries[q]); }, kQueryGrain);
+  return result;
+}
+
+/**
+ * @brief Batched k-NN: the neighbors of query q are at [q * k', (q + 1) * k'),
+ * with k' = min(k, size()).
+ */
+template <typename PointT>
+std::vector<PointIndex> BasicKdTree<PointT>::KNearest(const PointVector& queries,
+                                                      size_t k) const {
+  k = std::min(k, size());
+  std::vector<PointIndex> result(queries.size() * k);
+  ParallelFor(
+      queries.size(),
+      [&](size_t q) {
+        thread_local std::vector<Neighbor> neighbors;
+        KNearest(queries[q], k, neighbors);
+        for (size_t t = 0; t < k; ++t) {
+          result[q * k + t] = neighbors[t].second;
+        }
+      },
+      kQueryGrain);
+  return result;
+}
+
+/**
+ * @brief Batched radius query in CSR form: the points of query q are at
+ * [offsets[q], offsets[q + 1]).
+ */
+template <typename PointT>
+void BasicKdTree<PointT>::Radius(const PointVector& queries,
+                                 double radius,
+                                 std::vector<size_t>& offsets,
+                                 std::vector<PointIndex>& result) const {
+  std::vector<std::vector<PointIndex>> found(queries.size());
+  ParallelFor(
+      queries.size(), [&](size_t q) { Radius(queries[q], radius, found[q]); }, kQueryGrain);
+
+  offsets.assign(queries.size() + 1, 0);
+  for (size_t q = 0; q < queries.size(); ++q) {
+    offsets[q + 1] = offsets[q] + found[q].size();
+  }
+  result.resize(offsets.back());
+  for (size_t q = 0; q < queries.size(); ++q) {
+    std::copy(found[q].begin(), found[q].end(), result.begin() + offsets[q]);
+  }
+}
+
+/**
+ * @brief Nearest point in every octant around the query, the arcs of the
+ * octant graph that contains an EMST. The cells of the tree are pruned when
+ * none of the octants they overlap can improve.
+ *
+ * Ties go to the lowest index, so duplicate points all pick the same one and
+ * stay connected by arcs of length zero. Duplicates do not take up an octant,
+ * where they would hide the points beyond them.
+ */
+template <typename PointT>
+void BasicKdTree<PointT>::NearestInOctants(const PointT& query,
+                                           PointIndex self,
+                                           OctantNeighbors& best) const {
+  if (entries_.empty()) {
+    return;
+  }
+  const Cell cell{{double(min_.x), double(min_.y)}, {double(max_.x), double(max_.y)}};
+  SearchOctants(0, entries_.size(), cell, query, self, best);
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::SearchKNearest(size_t low,
+                                         size_t high,
+                                         const PointT& query,
+                                         size_t k,
+                                         std::vector<Neighbor>& heap) const {
+  auto offer = [&](const Entry& entry) {
+    const double dist = SquaredDistance(query, entry.point);
+    if (heap.size() < k) {
+      heap.emplace_back(dist, entry.index);
+      std::push_heap(heap.begin(), heap.end());
+    } else if (dist < heap.front().first) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = {dist, entry.index};
+      std::push_heap(heap.begin(), heap.end());
+    }
+  };
+
+  if (high - low <= kLeafSize) {
+    for (size_t i = low; i < high; ++i) {
+      offer(entries_[i]);
+    }
+    return;
+  }
+
+  const size_t mid = low + (high - low) / 2;
+  const Entry& node = entries_[mid];
+  offer(node);
+  const double diff = Coordinate(query, node.axis) - Coordinate(node.point, node.axis);
+  if (diff < 0) {
+    SearchKNearest(low, mid, query, k, heap);
+    if (heap.size() < k || diff * diff < heap.front().first) {
+      SearchKNearest(mid + 1, high, query, k, heap);
+    }
+  } else {
+    SearchKNearest(mid + 1, high, query, k, heap);
+    if (heap.size() < k || diff * diff < heap.front().first) {
+      SearchKNearest(low, mid, query, k, heap);
+    }
+  }
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::SearchRadius(size_t low,
+                                       size_t high,
+                                       const PointT& query,
+                                       double radius2,
+                                       std::vector<PointIndex>& result) const {
+  if (high - low <= kLeafSize) {
+    for (size_t i = low; i < high; ++i) {
+      if (SquaredDistance(query, entries_[i].point) <= radius2) {
+        result.push_back(entries_[i].index);
+      }
+    }
+    return;
+  }
+
+  const size_t mid = low + (high - low) / 2;
+  const Entry& node = entries_[mid];
+  if (SquaredDistance(query, node.point) <= radius2) {
+    result.push_back(node.index);
+  }
+  const double diff = Coordinate(query, node.axis) - Coordinate(node.point, node.axis);
+  if (diff <= 0 || diff * diff <= radius2) {
+    SearchRadius(low, mid, query, radius2, result);
+  }
+  if (diff >= 0 || diff * diff <= radius2) {
+    SearchRadius(mid + 1, high, query, radius2, result);
+  }
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::SearchRectangle(size_t low,
+                                          size_t high,
+                                          const PointT& min,
+                                          const PointT& max,
+                                          std::vector<PointIndex>& result) const {
+  auto inside = [&](const PointT& point) {
+    return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y;
+  };
+
+  if (high - low <= kLeafSize) {
+    for (size_t i = low; i < high; ++i) {
+      if (inside(entries_[i].point)) {
+        result.push_back(entries_[i].index);
+      }
+    }
+    return;
+  }
+
+  const size_t mid = low + (high - low) / 2;
+  const Entry& node = entries_[mid];
+  if (inside(node.point)) {
+    result.push_back(node.index);
+  }
+  const double split = Coordinate(node.point, node.axis);
+  if (Coordinate(min, node.axis) <= split) {
+    SearchRectangle(low, mid, min, max, result);
+  }
+  if (Coordinate(max, node.axis) >= split) {
+    SearchRectangle(mid + 1, high, min, max, result);
+  }
+}
+
+template <typename PointT>
+void BasicKdTree<PointT>::SearchOctants(size_t low,
+                                        size_t high,
+                                        const Cell& cell,
+                                        const PointT& query,
+                                        PointIndex self,
+                                        OctantNeighbors& best) const {
+  if (low == high || !MayImproveOctant(cell.min[0] - query.x, cell.max[0] - query.x,
+                                       cell.min[1] - query.y, cell.max[1] - query.y, best)) {
+    return;
+  }
+  auto offer = [&](const Entry& entry) {
+    if (entry.index == self) {
+      return;
+    }
+    const double dx = static_cast<double>(entry.point.x) - query.x;
+    const double dy = static_cast<double>(entry.point.y) - query.y;
+    const Neighbor candidate{dx * dx + dy * dy, entry.index};
+    Neighbor& slot = best[Octant(dx, dy)];
+    if (candidate < slot) {
+      slot = candidate;
+    }
+  };
+
+  if (high - low <= kLeafSize) {
+    for (size_t i = low; i < high; ++i) {
+      offer(entries_[i]);
+    }
+    return;
+  }
+
+  const size_t mid = low + (high - low) / 2;
+  const Entry& node = entries_[mid];
+  offer(node);
+  const std::uint32_t axis = node.axis;
+  const double split = Coordinate(node.point, axis);
+  Cell below = cell;
+  Cell above = cell;
+  below.max[axis] = split;
+  above.min[axis] = split;
+  if (Coordinate(query, axis) < split) {
+    SearchOctants(low, mid, below, query, self, best);
+    SearchOctants(mid + 1, high, above, query, self, best);
+  } else {
+    SearchOctants(mid + 1, high, above, query, self, best);
+    SearchOctants(low, mid, below, query, self, best);
+  }
+}
+
+template class BasicKdTree<Point>;
+template class BasicKdTree<PointF>;
+template class BasicKdTree<PointI>;
+
+}  // namespace cya
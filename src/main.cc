@@ -14,6 +14,7 @@
  * Referencias:
  */
 
+#include <cstdlib>
 #include <exception>
 #include <iostream>
 
@@ -25,6 +26,7 @@ int main(const int argc, const char* argv[]) {
     program.Run();
   } catch (const std::exception& exception) {
     std::cerr << exception.what() << std::endl;
+    return EXIT_FAILURE;
   }
   return 0;
 }
@@ -0,0 +1,82 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo mapped_file.cc: Implementación de la proyección de ficheros
+ * Referencias:
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <utility>
+
+#include "cya/mapped_file.h"
+
+namespace cya {
+
+MappedFile::MappedFile(const std::string& filename) {
+  const int descriptor = ::open(filename.c_str(), O_RDONLY);
+  if (descriptor == -1) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+
+  struct stat status;
+  if (::fstat(descriptor, &status) == -1 || !S_ISREG(status.st_mode)) {
+    ::close(descriptor);
+    throw std::runtime_error("Could not map file: " + filename);
+  }
+
+  size_ = status.st_size;
+  if (size_ > 0) {
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (address == MAP_FAILED) {
+      ::close(descriptor);
+      throw std::runtime_error("Could not map file: " + filename);
+    }
+    ::madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(address);
+  }
+  // The mapping stays valid after the descriptor is closed
+  ::close(descriptor);
+}
+
+MappedFile::~MappedFile() { Unmap(); }
+
+bool MappedFile::IsRegularFile(const std::string& filename) {
+  struct stat status;
+  return ::stat(filename.c_str(), &status) == 0 && S_ISREG(status.st_mode);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+void MappedFile::Unmap() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+}  // namespace cya
@@ -10,47 +10,60 @@
  * Autor: Pablo Hernández Jiménez
  * Correo: alu0101495934@ull.edu.es
  * Fecha: 19/09/2024
- * Archivo pointset.cc: Implementación de la clase PointSet
+ * Archivo pointset.cc: Implementación de la clase BasicPointSet
  * Referencias:
  */
 
 #include <algorithm>
 #include <cerrno>
 #include <cmath>
-#include <execution>
-#include <fstream>
-#include <iomanip>
-#include <map>
-
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "cya/buffered_writer.h"
+#include "cya/geometry.h"
+#include "cya/graph_writer.h"
+#include "cya/parallel.h"
 #include "cya/point_types.h"
 #include "cya/pointset.h"
+#include "cya/radix_sort.h"
 
 namespace cya {
 
-void PointSet::EMST() {
-  ArcVector arcs;
-  ComputeArcVector(arcs);
+template <typename PointT>
+void BasicPointSet<PointT>::EMST() {
+  IndexTree tree;
+  IndexTree arcs;
+  std::vector<RadixRecord> order;
+  ComputeArcVector(arcs, order);
   Forest forest;
 
-  for (const Point& point : *this) {
+  for (const PointT& point : *this) {
     SubTree subTree;
     subTree.AddPoint(point);
     forest.emplace_back(std::move(subTree));
   }
 
-  for (const WeightedArc& arc : arcs) {
+  for (const RadixRecord& record : order) {
+    const IndexArc& indices = arcs[record.index];
+    const Arc arc((*this)[indices.first], (*this)[indices.second]);
     int i = -1, j = -1;
-    FindIncidentSubtrees(forest, arc.second, i, j);
+    FindIncidentSubtrees(forest, arc, i, j);
     if (i != j && i != -1 && j != -1) {
-      MergeSubtrees(forest, arc.second, i, j);
+      MergeSubtrees(forest, arc, i, j);
+      tree.push_back(indices);
     }
   }
-  emst_ = forest[0].GetArcs();
+  SetTree(std::move(tree));
 }
 
-void PointSet::EMSTImproved(int start_point) {
-  emst_.clear();
+template <typename PointT>
+void BasicPointSet<PointT>::EMSTImproved(int start_point) {
+  IndexTree tree;
   if (size() <= 1) {
+    SetTree(std::move(tree));
     return;
   }
 
@@ -58,9 +71,9 @@ void PointSet::EMSTImproved(int start_point) {
   std::vector<bool> connected(size(), false);
   connected[start_point] = true;
 
-  while (emst_.size() < size() - 1) {
+  while (tree.size() < size() - 1) {
     double min_distance = std::numeric_limits<double>::max();
-    Arc closest_arc;
+    IndexArc closest_arc;
     int closest_index = -1;
 
     // Find the closest unconnected point to any connected point
@@ -75,51 +88,473 @@ void PointSet::EMSTImproved(int start_point) {
         double dist = EuclideanDistance(std::make_pair((*this)[i], (*this)[j]));
         if (dist < min_distance) {
           min_distance = dist;
-          closest_arc = {(*this)[j], (*this)[i]};
+          closest_arc = {PointIndex(j), PointIndex(i)};
           closest_index = i;
         }
       }
     }
 
     if (closest_index != -1) {
-      emst_.push_back(closest_arc);
+      tree.push_back(closest_arc);
       connected[closest_index] = true;
       continue;
     }
 
     break;
   }
+  SetTree(std::move(tree));
 }
 
-PointSet PointSet::EMSTMultistart() {
-  PointSet& original = *this;
-  PointSet& working_copy = original;
-  PointSet& best_tree = original;
+/**
+ * @brief Runs EMSTImproved() from every start point and keeps the cheapest
+ * tree. Only the arcs are kept between runs, so no copy of the set is made.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::EMSTMultistart() {
+  IndexTree best_tree;
+  double best_cost = std::numeric_limits<double>::infinity();
   for (size_t i = 0; i < size(); ++i) {
-    working_copy.EMSTImproved(i);
-    if (working_copy.ComputeCost() < best_tree.ComputeCost()) {
-      best_tree = working_copy;
+    EMSTImproved(i);
+    const double cost = ComputeCost();
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_tree = tree_;
     }
-    working_copy = original;
   }
-  return best_tree;
+  SetTree(std::move(best_tree));
+}
+
+/**
+ * @brief Kruskal over the octant graph: the arcs from every point to its
+ * nearest neighbor in each of the eight 45 degree octants around it.
+ *
+ * The result is an exact EMST in O(n) memory, see OctantNeighborGraph().
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::EMSTSparse() {
+  SetTree({});
+  if (size() <= 1) {
+    return;
+  }
+
+  if (size() > std::numeric_limits<PointIndex>::max()) {
+    throw std::runtime_error("Too many points for the EMST: " + std::to_string(size()));
+  }
+
+  GetKdTree();
+  IndexTree candidates;
+  OctantNeighborGraph(0, candidates);
+
+  DisjointSet components(size());
+  IndexTree tree;
+  tree.reserve(size() - 1);
+  KruskalOnCandidates(candidates, components, tree);
+  if (components.GetComponentCount() > 1) {
+    throw std::runtime_error("The octant graph does not span every point.");
+  }
+  SetTree(std::move(tree));
+}
+
+/**
+ * @brief Adds a batch of points and updates the EMST incrementally.
+ *
+ * The new EMST is contained in the old one plus the arcs that touch the new
+ * points, and among those the octant arcs of the new points are enough. An
+ * arc pq from a new point p whose octant holds a nearer r is swapped as in
+ * OctantNeighborGraph(); when r and q are both old, the old tree path between
+ * them stands for rq. So only the octant neighbors of the batch are searched
+ * and merged with the current tree arcs, and the result is exact as long as
+ * the current tree is. No distance between two old points is computed. The tree
+ * is kept sorted by length between batches, so only the candidates of the
+ * batch are sorted and Kruskal walks both runs in a single merge.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::AddPoints(const PointVector& batch) {
+  const size_t old_size = size();
+  if (old_size > 1 && tree_.size() != old_size - 1) {
+    throw std::runtime_error("The EMST must be computed before adding points.");
+  }
+  if (old_size + batch.size() > std::numeric_limits<PointIndex>::max()) {
+    throw std::runtime_error("Too many points for the EMST.");
+  }
+
+  insert(end(), batch.begin(), batch.end());
+  // New points keep their position, which is also their original index
+  if (!permutation_.empty()) {
+    for (size_t i = old_size; i < size(); ++i) {
+      permutation_.push_back(i);
+    }
+  }
+  if (size() <= 1 || batch.empty()) {
+    SetTree(std::move(tree_));
+    return;
+  }
+
+  SortTreeByLength();
+  UpdateIndex();
+  IndexTree candidates;
+  OctantNeighborGraph(old_size, candidates);
+  std::vector<RadixRecord> order(candidates.size());
+  ParallelFor(candidates.size(), [&](size_t index) {
+    const IndexArc& arc = candidates[index];
+    order[index] = {OrderedKey(SquaredDistance((*this)[arc.first], (*this)[arc.second])),
+                    PointIndex(index)};
+  });
+  RadixSort(order);
+
+  DisjointSet components(size());
+  std::vector<std::pair<std::uint64_t, IndexArc>> merged;
+  merged.reserve(size() - 1);
+  size_t old_arc = 0;
+  size_t new_arc = 0;
+  while (components.GetComponentCount() > 1 &&
+         (old_arc < tree_.size() || new_arc < order.size())) {
+    const bool take_old = new_arc == order.size() ||
+                          (old_arc < tree_.size() && tree_keys_[old_arc] <= order[new_arc].key);
+    const std::uint64_t key = take_old ? tree_keys_[old_arc] : order[new_arc].key;
+    const IndexArc arc = take_old ? tree_[old_arc++] : candidates[order[new_arc++].index];
+    if (components.Union(arc.first, arc.second)) {
+      merged.emplace_back(key, arc);
+    }
+  }
+  if (components.GetComponentCount() > 1) {
+    throw std::runtime_error("The octant graph does not span every point.");
+  }
+
+  IndexTree tree(merged.size());
+  std::vector<std::uint64_t> keys(merged.size());
+  for (size_t i = 0; i < merged.size(); ++i) {
+    std::tie(keys[i], tree[i]) = merged[i];
+  }
+  SetTree(std::move(tree));
+  tree_keys_ = std::move(keys);
+}
+
+/**
+ * @brief Puts the tree in order of length and keeps the keys, unless that is
+ * done already. Kruskal trees come out sorted and only need their keys.
+ *
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::SortTreeByLength() {
+  if (tree_keys_.size() == tree_.size()) {
+    return;
+  }
+  std::vector<RadixRecord> order(tree_.size());
+  ParallelFor(tree_.size(), [&](size_t index) {
+    const IndexArc& arc = tree_[index];
+    order[index] = {OrderedKey(SquaredDistance((*this)[arc.first], (*this)[arc.second])),
+                    PointIndex(index)};
+  });
+  if (!std::is_sorted(order.begin(), order.end(), [](const RadixRecord& a, const RadixRecord& b) {
+        return a.key < b.key;
+      })) {
+    RadixSort(order);
+  }
+  IndexTree tree(tree_.size());
+  tree_keys_.resize(tree_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    tree[i] = tree_[order[i].index];
+    tree_keys_[i] = order[i].key;
+  }
+  tree_ = std::move(tree);
+}
+
+/**
+ * @brief Sorts the points along a space-filling curve so that points close
+ * in space are close in memory.
+ *
+ * The keys are computed in parallel and radix sorted. The permutation is
+ * kept, so GetOriginalIndex() still reports results in input order. The
+ * tree is remapped to the new indices and the spatial indexes are dropped.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::SpatialReorder(Curve curve) {
+  std::vector<RadixRecord> order = CurveKeys(std::span<const PointT>(data(), size()), curve);
+  RadixSort(order);
+
+  PointVector sorted(size());
+  std::vector<PointIndex> permutation(size());
+  std::vector<PointIndex> new_index(size());
+  ParallelFor(order.size(), [&](size_t i) {
+    const RadixRecord& record = order[i];
+    sorted[i] = (*this)[record.index];
+    permutation[i] = GetOriginalIndex(record.index);
+    new_index[record.index] = i;
+  });
+  PointVector::swap(sorted);
+  permutation_ = std::move(permutation);
+
+  IndexTree tree = std::move(tree_);
+  for (IndexArc& arc : tree) {
+    arc = {new_index[arc.first], new_index[arc.second]};
+  }
+  SetTree(std::move(tree));
+  index_levels_.clear();
+  grid_.reset();
+}
+
+/**
+ * @brief Spatial index over all the points, shared by the EMST engines and
+ * the neighbor queries. Built on first use.
+ *
+ */
+template <typename PointT>
+const BasicKdTree<PointT>& BasicPointSet<PointT>::GetKdTree() const {
+  if (index_levels_.size() != 1 || index_levels_.front().size() != size()) {
+    index_levels_.clear();
+    index_levels_.emplace_back(std::span<const PointT>(data(), size()));
+  }
+  return index_levels_.front();
 }
 
-void PointSet::ComputeArcVector(ArcVector& arcs) const {
-  arcs.clear();
-  const int n = size();
-  for (int i = 0; i < n - 1; ++i) {
-    const Point& p_i = (*this)[i];
-    for (int j = i + 1; j < n; ++j) {
-      const Point& p_j = (*this)[j];
-      const double dist = EuclideanDistance(std::make_pair(p_i, p_j));
-      arcs.emplace_back(dist, std::make_pair(p_i, p_j));
+/**
+ * @brief Uniform grid over all the points, the faster index for near-uniform
+ * clouds. Built on first use.
+ *
+ */
+template <typename PointT>
+const BasicUniformGrid<PointT>& BasicPointSet<PointT>::GetGrid() const {
+  if (!grid_ || grid_->size() != size()) {
+    grid_.emplace(std::span<const PointT>(data(), size()));
+  }
+  return *grid_;
+}
+
+/**
+ * @brief Indexes the points appended since the last update.
+ *
+ * Appended points get a k-d tree of their own, and consecutive trees are
+ * rebuilt together like a binary counter whenever the older one is not
+ * more than twice the size of the newer one. There are O(log n) trees and
+ * each point is rebuilt O(log n) times, so indexing a batch costs about
+ * the same as the batch itself.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::UpdateIndex() {
+  size_t indexed = 0;
+  for (const KdTree& level : index_levels_) {
+    indexed += level.size();
+  }
+  if (indexed > size()) {
+    index_levels_.clear();
+    indexed = 0;
+  }
+  if (indexed < size()) {
+    index_levels_.emplace_back(std::span<const PointT>(data() + indexed, size() - indexed),
+                               indexed);
+  }
+
+  while (index_levels_.size() >= 2 &&
+         index_levels_.end()[-2].size() <= 2 * index_levels_.back().size()) {
+    const PointIndex offset = index_levels_.end()[-2].GetOffset();
+    const size_t count = index_levels_.end()[-2].size() + index_levels_.back().size();
+    index_levels_.resize(index_levels_.size() - 2);
+    index_levels_.emplace_back(std::span<const PointT>(data() + offset, count), offset);
+  }
+}
+
+/**
+ * @brief Candidate arcs from every point in [first, n) to its nearest
+ * neighbor in each octant around it and to its first duplicate, at most nine
+ * per point.
+ *
+ * Some EMST only uses these arcs: if an EMST arc pq leaves p in an octant
+ * whose nearest point is r, the angle rpq is at most 45 degrees, so pr is no
+ * longer than pq and rq is shorter, and the cycle through r lets pq be
+ * swapped for one of them. Duplicates all link to the first of them. Candidates are
+ * sorted through records that hold their index,
+ * so there may be at most as many as a PointIndex can number.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::OctantNeighborGraph(PointIndex first, IndexTree& candidates) const {
+  const size_t n = size();
+  const size_t slots = std::tuple_size_v<OctantNeighbors>;
+  const size_t candidate_count = (n - first) * slots;
+  if (candidate_count > std::numeric_limits<PointIndex>::max()) {
+    throw std::runtime_error("Too many candidate arcs for the EMST: " +
+                             std::to_string(candidate_count));
+  }
+
+  candidates.assign(candidate_count, IndexArc{0, 0});
+  const double infinity = std::numeric_limits<double>::infinity();
+  ParallelFor(
+      n - first,
+      [&](size_t q) {
+        const PointIndex i = first + q;
+        OctantNeighbors best;
+        best.fill({infinity, i});
+        for (const KdTree& level : index_levels_) {
+          level.NearestInOctants((*this)[i], i, best);
+        }
+        // Empty octants leave the loop i-i, dropped below
+        for (size_t slot = 0; slot < slots; ++slot) {
+          const PointIndex j = best[slot].second;
+          candidates[q * slots + slot] = {std::min(i, j), std::max(i, j)};
+        }
+      },
+      kQueryGrain);
+  std::erase_if(candidates, [](const IndexArc& arc) { return arc.first == arc.second; });
+}
+
+template <typename PointT>
+void BasicPointSet<PointT>::KruskalOnCandidates(const IndexTree& candidates,
+                                                DisjointSet& components, IndexTree& tree) const {
+  // Arcs found from both endpoints are kept; the second copy is rejected by
+  // the union-find, which is cheaper than deduplicating
+  std::vector<RadixRecord> order(candidates.size());
+  ParallelFor(candidates.size(), [&](size_t index) {
+    const IndexArc& arc = candidates[index];
+    order[index] = {OrderedKey(SquaredDistance((*this)[arc.first], (*this)[arc.second])),
+                    PointIndex(index)};
+  });
+  RadixSort(order);
+
+  for (const RadixRecord& record : order) {
+    const IndexArc& arc = candidates[record.index];
+    if (components.Union(arc.first, arc.second)) {
+      tree.push_back(arc);
+      if (components.GetComponentCount() == 1) {
+        break;
+      }
     }
   }
-  std::sort(arcs.begin(), arcs.end());
 }
 
-void PointSet::FindIncidentSubtrees(const Forest& forest, const Arc& arc, int& i, int& j) const {
+/**
+ * @brief Stores a freshly computed tree and builds its degree array. The CSR
+ * adjacency and the hash index of coordinates are dropped and only rebuilt
+ * when they are queried.
+ *
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::SetTree(IndexTree tree) {
+  tree_ = std::move(tree);
+  emst_.clear();
+
+  const size_t n = size();
+  degree_.assign(n, 0);
+  for (const IndexArc& arc : tree_) {
+    ++degree_[arc.first];
+    ++degree_[arc.second];
+  }
+
+  adjacency_offsets_.clear();
+  adjacency_.clear();
+  tree_keys_.clear();
+  point_index_.clear();
+}
+
+/**
+ * @brief Points joined to `index` by a tree arc. The CSR adjacency is built
+ * on the first call after the tree changes.
+ *
+ */
+template <typename PointT>
+std::span<const PointIndex> BasicPointSet<PointT>::GetNeighbors(PointIndex index) const {
+  if (index >= degree_.size()) {
+    return {};
+  }
+  if (adjacency_offsets_.empty()) {
+    adjacency_offsets_.assign(degree_.size() + 1, 0);
+    std::inclusive_scan(degree_.begin(), degree_.end(), adjacency_offsets_.begin() + 1);
+    adjacency_.resize(2 * tree_.size());
+    std::vector<PointIndex> next(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+    for (const IndexArc& arc : tree_) {
+      adjacency_[next[arc.first]++] = arc.second;
+      adjacency_[next[arc.second]++] = arc.first;
+    }
+  }
+  return {adjacency_.data() + adjacency_offsets_[index],
+          adjacency_.data() + adjacency_offsets_[index + 1]};
+}
+
+/**
+ * @brief Hash index of coordinates, built on first use.
+ *
+ * Duplicate coordinates resolve to their first occurrence.
+ */
+template <typename PointT>
+const std::unordered_map<PointT, PointIndex, PointHash>& BasicPointSet<PointT>::GetPointIndex()
+    const {
+  if (point_index_.empty() && !empty()) {
+    point_index_.reserve(size());
+    for (size_t i = 0; i < size(); ++i) {
+      point_index_.emplace((*this)[i], PointIndex(i));
+    }
+  }
+  return point_index_;
+}
+
+/**
+ * @brief Tree as pairs of points, materialized from the index tree on demand.
+ *
+ */
+template <typename PointT>
+const typename BasicPointSet<PointT>::Tree& BasicPointSet<PointT>::GetTree() const {
+  if (emst_.size() != tree_.size()) {
+    emst_.clear();
+    emst_.reserve(tree_.size());
+    for (const IndexArc& arc : tree_) {
+      emst_.emplace_back((*this)[arc.first], (*this)[arc.second]);
+    }
+  }
+  return emst_;
+}
+
+template <typename PointT>
+std::optional<PointIndex> BasicPointSet<PointT>::FindPoint(const PointT& point) const {
+  const auto& point_index = GetPointIndex();
+  const auto it = point_index.find(point);
+  if (it == point_index.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+template <typename PointT>
+std::vector<int> BasicPointSet<PointT>::GetPointOrders(const PointVector& points) const {
+  std::vector<int> orders(points.size());
+  // Built here so the parallel lookups only read it
+  GetPointIndex();
+  ParallelFor(points.size(), [&](size_t i) { orders[i] = GetPointOrder(points[i]); });
+  return orders;
+}
+
+/**
+ * @brief Computes every arc as a pair of indices together with its sort order.
+ *
+ * Arcs are ordered through compact (key, arc index) records radix sorted on
+ * the squared distance, so no square root is taken until an arc is merged.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::ComputeArcVector(IndexTree& arcs,
+                                             std::vector<RadixRecord>& order) const {
+  const size_t n = size();
+  const size_t arc_count = n < 2 ? 0 : n * (n - 1) / 2;
+  if (arc_count > std::numeric_limits<PointIndex>::max()) {
+    throw std::runtime_error("Too many points for the complete graph: " + std::to_string(n));
+  }
+  arcs.resize(arc_count);
+  order.resize(arc_count);
+
+  ParallelFor(
+      n,
+      [&](size_t i) {
+        const PointT& p_i = (*this)[i];
+        size_t offset = i * (2 * n - i - 1) / 2;
+        for (size_t j = i + 1; j < n; ++j, ++offset) {
+          arcs[offset] = {PointIndex(i), PointIndex(j)};
+          order[offset] = {OrderedKey(SquaredDistance(p_i, (*this)[j])), PointIndex(offset)};
+        }
+      },
+      kQueryGrain);
+  RadixSort(order);
+}
+
+template <typename PointT>
+void BasicPointSet<PointT>::FindIncidentSubtrees(const Forest& forest, const Arc& arc, int& i,
+                                                 int& j) const {
   i = j = 0;
   for (const SubTree& subtree : forest) {
     if (subtree.Contains(arc.first)) {
@@ -131,30 +566,37 @@ void PointSet::FindIncidentSubtrees(const Forest& forest, const Arc& arc, int& i
   }
 }
 
-double PointSet::ComputeCost() const {
+template <typename PointT>
+double BasicPointSet<PointT>::ComputeCost() const {
   double cost = 0.0;
-  for (const Arc& arc : emst_) {
-    cost += EuclideanDistance(arc);
+  for (const IndexArc& arc : tree_) {
+    cost += std::sqrt(SquaredDistance((*this)[arc.first], (*this)[arc.second]));
   }
   return cost;
 }
 
-double PointSet::EuclideanDistance(const Arc& arc) const {
-  const double dx = arc.first.x - arc.second.x;
-  const double dy = arc.first.y - arc.second.y;
-  return std::sqrt(dx * dx + dy * dy);
+template <typename PointT>
+double BasicPointSet<PointT>::EuclideanDistance(const Arc& arc) const {
+  return std::sqrt(SquaredDistance(arc.first, arc.second));
 }
 
-void PointSet::MergeSubtrees(Forest& forest, const Arc& arc, int i, int j) {
+template <typename PointT>
+double BasicPointSet<PointT>::SquaredDistance(const PointT& a, const PointT& b) const {
+  return cya::SquaredDistance(a, b);
+}
+
+template <typename PointT>
+void BasicPointSet<PointT>::MergeSubtrees(Forest& forest, const Arc& arc, int i, int j) {
   forest[i].Merge(forest[j], std::make_pair(EuclideanDistance(arc), arc));
   forest.erase(forest.begin() + j);
 }
 
-void PointSet::QuickHull() {
+template <typename PointT>
+void BasicPointSet<PointT>::QuickHull() {
   hull_.clear();
 
-  Point min_x_point;
-  Point max_x_point;
+  PointT min_x_point;
+  PointT max_x_point;
 
   XBounds(min_x_point, max_x_point);
 
@@ -166,8 +608,9 @@ void PointSet::QuickHull() {
   hull_.erase(std::unique(hull_.begin(), hull_.end()), hull_.end());
 }
 
-void PointSet::QuickHull(const Line& line, int side) {
-  Point farthest;
+template <typename PointT>
+void BasicPointSet<PointT>::QuickHull(const Line& line, int side) {
+  PointT farthest;
 
   if (FarthestPoint(line, side, farthest)) {
     QuickHull(Line(line.first, farthest), -FindSide(Line(line.first, farthest), line.second));
@@ -178,14 +621,15 @@ void PointSet::QuickHull(const Line& line, int side) {
   }
 }
 
-void PointSet::QuickHullImproved() {
+template <typename PointT>
+void BasicPointSet<PointT>::QuickHullImproved() {
   if (size() < 3) {
     hull_ = *this;
     return;
   }
 
-  Point min_x = PointVector::at(0);
-  Point max_x = PointVector::at(0);
+  PointT min_x = PointVector::at(0);
+  PointT max_x = PointVector::at(0);
 
   XBounds(min_x, max_x);
 
@@ -198,8 +642,9 @@ void PointSet::QuickHullImproved() {
   hull_.erase(std::unique(hull_.begin(), hull_.end()), hull_.end());
 }
 
-void PointSet::QuickHullImproved(const Line& line, int side) {
-  Point farthest;
+template <typename PointT>
+void BasicPointSet<PointT>::QuickHullImproved(const Line& line, int side) {
+  PointT farthest;
   if (FarthestPointImproved(line, side, farthest)) {
     QuickHullImproved(Line(line.first, farthest),
                       -FindSide(Line(line.first, farthest), line.second));
@@ -212,12 +657,13 @@ void PointSet::QuickHullImproved(const Line& line, int side) {
   }
 }
 
-bool PointSet::FarthestPoint(const Line& line, int side, Point& farthest) const {
+template <typename PointT>
+bool BasicPointSet<PointT>::FarthestPoint(const Line& line, int side, PointT& farthest) const {
   farthest = PointVector::at(0);
   double max_dist = 0;
   bool found = false;
 
-  for (const Point& point : *this) {
+  for (const PointT& point : *this) {
     const double dist = Distance(line, point);
 
     if (FindSide(line, point) == side && dist > max_dist) {
@@ -230,136 +676,303 @@ bool PointSet::FarthestPoint(const Line& line, int side, Point& farthest) const
   return found;
 }
 
-bool PointSet::FarthestPointImproved(const Line& line, int side, Point& farthest) const {
-  double max_dist = -1;
-  bool found = false;
-
-  std::for_each(
-      __pstl::execution::par, PointVector::begin(), PointVector::end(), [&](const Point& point) {
-        if (FindSide(line, point) == side) {
-          double dist = Distance(line, point);
-          if (dist > max_dist) {
-            max_dist = dist;
-            farthest = point;
-            found = true;
-          }
+/**
+ * @brief FarthestPoint() over parallel chunks. Every chunk keeps its own
+ * farthest point and the chunks are combined in order, so ties resolve to the
+ * first point like in the sequential search.
+ */
+template <typename PointT>
+bool BasicPointSet<PointT>::FarthestPointImproved(const Line& line, int side,
+                                                  PointT& farthest) const {
+  const size_t n = size();
+  const size_t chunks = ParallelChunkCount(n);
+  std::vector<std::pair<double, PointIndex>> best(chunks, {-1, 0});
+  ParallelChunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const PointT& point = (*this)[i];
+      if (FindSide(line, point) == side) {
+        const double dist = Distance(line, point);
+        if (dist > best[chunk].first) {
+          best[chunk] = {dist, PointIndex(i)};
         }
-      });
+      }
+    }
+  });
 
+  double max_dist = -1;
+  bool found = false;
+  for (const auto& [dist, index] : best) {
+    if (dist > max_dist) {
+      max_dist = dist;
+      farthest = (*this)[index];
+      found = true;
+    }
+  }
   return found;
 }
 
-int PointSet::FindSide(const Line& line, const Point& p) const {
-  double val = (p.y - line.first.y) * (line.second.x - line.first.x) -
-               (p.x - line.first.x) * (line.second.y - line.first.y);
-  if (val > 0)
-    return 1;
-  if (val < 0)
-    return -1;
-  return 0;
+template <typename PointT>
+int BasicPointSet<PointT>::FindSide(const Line& line, const PointT& p) const {
+  return Orientation(line.first, line.second, p);
 }
 
-void PointSet::XBounds(Point& min_x, Point& max_x) const {
+template <typename PointT>
+void BasicPointSet<PointT>::XBounds(PointT& min_x, PointT& max_x) const {
   min_x =
-      *std::min_element(begin(), end(), [](const Point& a, const Point& b) { return a.x < b.x; });
+      *std::min_element(begin(), end(), [](const PointT& a, const PointT& b) { return a.x < b.x; });
   max_x =
-      *std::max_element(begin(), end(), [](const Point& a, const Point& b) { return a.x < b.x; });
+      *std::max_element(begin(), end(), [](const PointT& a, const PointT& b) { return a.x < b.x; });
 }
 
-double PointSet::PointToLine(const Line& line, const Point& point) const {
-  return std::abs((line.second.y - line.first.y) * point.x -
-                  (line.second.x - line.first.x) * point.y + line.second.x * line.first.y -
-                  line.second.y * line.first.x) /
-         std::sqrt(std::pow(line.second.y - line.first.y, 2) +
-                   std::pow(line.second.x - line.first.x, 2));
+template <typename PointT>
+double BasicPointSet<PointT>::PointToLine(const Line& line, const PointT& point) const {
+  const Point a{static_cast<double>(line.first.x), static_cast<double>(line.first.y)};
+  const Point b{static_cast<double>(line.second.x), static_cast<double>(line.second.y)};
+  const Point p{static_cast<double>(point.x), static_cast<double>(point.y)};
+  return std::abs((b.y - a.y) * p.x - (b.x - a.x) * p.y + b.x * a.y - b.y * a.x) /
+         std::sqrt(std::pow(b.y - a.y, 2) + std::pow(b.x - a.x, 2));
 }
 
-double PointSet::Distance(const Line& line, const Point& point) const {
+template <typename PointT>
+double BasicPointSet<PointT>::Distance(const Line& line, const PointT& point) const {
   return fabs(PointToLine(line, point));
 }
 
-struct PointPtrComparator {
-  bool operator()(const Point* a, const Point* b) const {
-    if (a->x != b->x)
-      return a->x < b->x;
-    return a->y < b->y;
-  }
-};
+template <typename PointT>
+void BasicPointSet<PointT>::WriteDot(const std::string& filename) const {
+  WriteGraph(filename, DOT);
+}
 
-void PointSet::WriteDot(const std::string& filename) const {
-  // Open file with error checking
-  std::ofstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Unable to open file: " + filename + " for writing.");
-  }
+template <typename PointT>
+void BasicPointSet<PointT>::WriteGraph(const std::string& filename, GraphFormat format) const {
+  GraphWriter writer(filename, format, *this);
+  writer.WriteNodes();
 
-  // Start dot graph with minimalist styling
-  file << "graph G {\n";
-  file << "  layout=neato;\n";
-  file << "  overlap=false;\n";
-  file << "  bgcolor=white;\n";
+  if (!tree_.empty()) {
+    writer.BeginEdges("gray", 0.5);
+    for (const auto& [from, to] : tree_) {
+      writer.WriteEdge(from, to);
+    }
+    writer.EndEdges();
+  }
 
-  // Node styling at the graph level
-  file << "  node [style=filled, color=black, fillcolor=black, width=0.05, height=0.05, "
-          "shape=point];\n";
+  WriteHullEdges(writer, HullIndices());
+  writer.Close();
+}
 
-  // Map points to unique numerical indices
-  std::map<Point*, int, PointPtrComparator> point_indices;
-  int counter = 0;
+template <typename PointT>
+void BasicPointSet<PointT>::WriteHullEdges(GraphWriter& writer,
+                                           const std::vector<PointIndex>& hull) const {
+  if (hull.size() < 2) {
+    return;
+  }
+  writer.BeginEdges("black", 1);
+  // Two points are joined once, a polygon is closed
+  const size_t edges = hull.size() == 2 ? 1 : hull.size();
+  for (size_t i = 0; i < edges; ++i) {
+    writer.WriteEdge(hull[i], hull[(i + 1) % hull.size()]);
+  }
+  writer.EndEdges();
+}
 
-  for (const Point& point : *this) {
-    if (point_indices.find(const_cast<Point*>(&point)) == point_indices.end()) {
-      point_indices[const_cast<Point*>(&point)] = counter++;
+/**
+ * @brief Writes a graph whose size does not depend on the amount of points.
+ *
+ * Points are binned into square cells, `resolution` of them along the longer
+ * side of the bounding box, and every occupied cell is drawn by its first
+ * point. Hull vertices and edges are kept exactly. EMST arcs at least
+ * `min_edge_length` long (one cell if not positive) join the cells of their
+ * ends; only one arc is kept per pair of cells, and only the longest
+ * resolution² of those.
+ */
+template <typename PointT>
+void BasicPointSet<PointT>::WriteDecimatedGraph(const std::string& filename, GraphFormat format,
+                                                size_t resolution, double min_edge_length) const {
+  constexpr size_t kMaxResolution = 2048;
+  constexpr PointIndex kEmpty = std::numeric_limits<PointIndex>::max();
+  resolution = std::clamp<size_t>(resolution, 1, kMaxResolution);
+
+  Point min{0.0, 0.0};
+  Point max{0.0, 0.0};
+  if (!empty()) {
+    min = max = {static_cast<double>(front().x), static_cast<double>(front().y)};
+    for (const PointT& point : *this) {
+      min = {std::min<double>(min.x, point.x), std::min<double>(min.y, point.y)};
+      max = {std::max<double>(max.x, point.x), std::max<double>(max.y, point.y)};
     }
   }
+  const double extent =
+      std::max({max.x - min.x, max.y - min.y, std::numeric_limits<double>::min()});
+  const double cell_size = extent / resolution;
+  auto cell_of = [&](const PointT& point) {
+    const size_t column = std::min<size_t>((point.x - min.x) / cell_size, resolution - 1);
+    const size_t row = std::min<size_t>((point.y - min.y) / cell_size, resolution - 1);
+    return row * resolution + column;
+  };
+
+  std::vector<PointIndex> representative(resolution * resolution, kEmpty);
+  for (PointIndex i = 0; i < size(); ++i) {
+    PointIndex& cell = representative[cell_of((*this)[i])];
+    cell = cell == kEmpty ? i : cell;
+  }
 
-  for (const auto& pair : point_indices) {
-    const Point& point = *pair.first;
-    int index = pair.second;
-
-    file << "  " << index << " [\n";
-    file << "    pos=\"" << std::fixed << std::setprecision(2) << point.x << "," << point.y
-         << "!\"\n";
-    file << "  ];\n";
+  const std::vector<PointIndex> hull = HullIndices();
+  std::vector<PointIndex> nodes;
+  std::copy_if(representative.begin(), representative.end(), std::back_inserter(nodes),
+               [](PointIndex index) { return index != kEmpty; });
+  for (const PointIndex index : hull) {
+    if (representative[cell_of((*this)[index])] != index) {
+      nodes.push_back(index);
+    }
   }
 
-  std::vector<Point> sorted_hull = hull_;
-  std::sort(sorted_hull.begin(), sorted_hull.end(), [this](const Point& a, const Point& b) {
-    return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+  const double threshold = min_edge_length > 0.0 ? min_edge_length : cell_size;
+  std::vector<std::pair<double, IndexArc>> arcs;
+  for (const auto& [from, to] : tree_) {
+    const double length = SquaredDistance((*this)[from], (*this)[to]);
+    const PointIndex a = representative[cell_of((*this)[from])];
+    const PointIndex b = representative[cell_of((*this)[to])];
+    if (length >= threshold * threshold && a != b) {
+      arcs.push_back({length, std::minmax(a, b)});
+    }
+  }
+  std::sort(arcs.begin(), arcs.end(), [](const auto& a, const auto& b) {
+    return a.second < b.second || (a.second == b.second && a.first > b.first);
   });
+  arcs.erase(std::unique(arcs.begin(), arcs.end(),
+                         [](const auto& a, const auto& b) { return a.second == b.second; }),
+             arcs.end());
+  const size_t max_arcs = resolution * resolution;
+  if (arcs.size() > max_arcs) {
+    std::nth_element(arcs.begin(), arcs.begin() + max_arcs, arcs.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    arcs.resize(max_arcs);
+  }
 
-  for (size_t i = 0; i < sorted_hull.size(); ++i) {
-    const Point& point = sorted_hull[i];
-    const Point& next_point = sorted_hull[(i + 1) % sorted_hull.size()];
+  GraphWriter writer(filename, format, *this);
+  writer.WriteNodes(nodes);
+  if (!arcs.empty()) {
+    writer.BeginEdges("gray", 0.5);
+    for (const auto& [length, arc] : arcs) {
+      writer.WriteEdge(arc.first, arc.second);
+    }
+    writer.EndEdges();
+  }
+  WriteHullEdges(writer, hull);
+  writer.Close();
+}
+
+/**
+ * @brief Index in the input of every hull vertex, in counter-clockwise order.
+ *
+ */
+template <typename PointT>
+std::vector<PointIndex> BasicPointSet<PointT>::GetHullIndices() const {
+  std::vector<PointIndex> indices = HullIndices();
+  for (PointIndex& index : indices) {
+    index = GetOriginalIndex(index);
+  }
+  return indices;
+}
 
-    int index = point_indices.at(const_cast<Point*>(&point));
-    int next_index = point_indices.at(const_cast<Point*>(&next_point));
+/**
+ * @brief EMST arcs as pairs of indices in the input.
+ *
+ */
+template <typename PointT>
+IndexTree BasicPointSet<PointT>::GetTreeIndices() const {
+  IndexTree tree = tree_;
+  for (auto& [from, to] : tree) {
+    from = GetOriginalIndex(from);
+    to = GetOriginalIndex(to);
+  }
+  return tree;
+}
 
-    file << "  " << index << " -- " << next_index << " [\n";
-    file << "    color=\"black\"\n";
-    file << "    penwidth=1\n";
-    file << "  ];\n";
+/**
+ * @brief Index of every hull vertex, in counter-clockwise order.
+ *
+ * The hull is kept sorted by x and then y, so its first and last vertices are
+ * the ends of the lower and the upper chain. Vertices below the line joining
+ * them go first from left to right, and the ones above come back from right to
+ * left. A point repeated in the input is represented by its first index.
+ */
+template <typename PointT>
+std::vector<PointIndex> BasicPointSet<PointT>::HullIndices() const {
+  std::unordered_map<PointT, PointIndex, PointHash> hull_index;
+  hull_index.reserve(hull_.size());
+  for (const PointT& point : hull_) {
+    hull_index.emplace(point, std::numeric_limits<PointIndex>::max());
+  }
+  for (PointIndex i = 0; i < size(); ++i) {
+    auto found = hull_index.find((*this)[i]);
+    if (found != hull_index.end() && found->second == std::numeric_limits<PointIndex>::max()) {
+      found->second = i;
+    }
   }
 
-  file << "}\n";
-  file.close();
+  std::vector<PointIndex> indices;
+  indices.reserve(hull_.size());
+  if (hull_.size() < 3) {
+    for (const PointT& point : hull_) {
+      indices.push_back(hull_index.at(point));
+    }
+    return indices;
+  }
 
-  if (!file.good()) {
-    throw std::runtime_error("Error occurred while writing to file: " + filename);
+  const Line chord(hull_.front(), hull_.back());
+  std::vector<PointIndex> upper;
+  for (const PointT& point : hull_) {
+    (FindSide(chord, point) > 0 ? upper : indices).push_back(hull_index.at(point));
   }
+  indices.insert(indices.end(), upper.rbegin(), upper.rend());
+  return indices;
 }
 
-void PointSet::Write(const std::string& filename) const {
-  std::ofstream file(filename);
+template <typename PointT>
+void BasicPointSet<PointT>::Write(const std::string& filename, PointFormat format) const {
+  if (format == BINARY) {
+    // The hull is small, so it is widened to double and written back in the
+    // coordinate type of the points
+    std::vector<Point> hull;
+    hull.reserve(hull_.size());
+    for (const PointT& point : hull_) {
+      hull.push_back({static_cast<double>(point.x), static_cast<double>(point.y)});
+    }
+    WriteBinaryPoints(filename, hull, AOS,
+                      static_cast<CoordinateType>(kNativeCoordinateType<CoordinateOf<PointT>>));
+    return;
+  }
 
-  if (!file.is_open()) {
-    throw std::runtime_error("Unable to open file for writing.");
+  BufferedWriter writer(filename);
+  for (const PointT& point : hull_) {
+    writer << '(' << point.x << ", " << point.y << ")\n";
   }
+  writer.Close();
+}
 
-  for (const Point& point : hull_) {
-    file << "(" << point.x << ", " << point.y << ")";
-    file << std::endl;
+template <typename PointT>
+void BasicPointSet<PointT>::WriteIndices(const std::string& filename, IndexKind kind) const {
+  if (kind == TREE_INDICES) {
+    WriteTreeIndices(filename, GetTreeIndices());
+  } else {
+    WriteHullIndices(filename, GetHullIndices());
   }
 }
 
+template <typename PointT>
+void BasicPointSet<PointT>::WriteTree(const std::string& filename) const {
+  BufferedWriter writer(filename);
+  for (const auto& [from, to] : tree_) {
+    const PointT& a = (*this)[from];
+    const PointT& b = (*this)[to];
+    writer << '(' << a.x << ", " << a.y << ") (" << b.x << ", " << b.y << ")\n";
+  }
+  writer.Close();
+}
+
+template class BasicPointSet<Point>;
+template class BasicPointSet<PointF>;
+template class BasicPointSet<PointI>;
+
 }  // namespace cya
\ No newline at end of file
@@ -14,26 +14,59 @@
  * Referencias:
  */
 
-#include <iomanip>
+#include <charconv>
 #include <iostream>
+#include <limits>
+#include <string>
 
 #include "cya/point_types.h"
 
 namespace cya {
 
+namespace {
+
+// Points are formatted into blocks of this size before reaching the stream
+constexpr size_t kFormatBlockSize = 1 << 16;
+
+// Same text as `std::setw(MAX_SIZE) << std::fixed << std::setprecision(MAX_PRECISION)`
+void AppendCoordinate(std::string& out, double value) {
+  char digits[std::numeric_limits<double>::max_exponent10 + MAX_PRECISION + 8];
+  const auto [end, error] = std::to_chars(
+      digits, digits + sizeof(digits), value, std::chars_format::fixed, MAX_PRECISION);
+  const size_t length = end - digits;
+  if (length < MAX_SIZE) {
+    out.append(MAX_SIZE - length, ' ');
+  }
+  out.append(digits, length);
+}
+
+void AppendPoint(std::string& out, const Point& point) {
+  AppendCoordinate(out, point.x);
+  out += '\t';
+  AppendCoordinate(out, point.y);
+}
+
+}  // namespace
+
 std::ostream& operator<<(std::ostream& os, const PointVector& points) {
-  os << points.size() << std::endl;
+  std::string block = std::to_string(points.size()) + '\n';
+  block.reserve(2 * kFormatBlockSize);
   for (const Point& point : points) {
-    os << point << std::endl;
+    AppendPoint(block, point);
+    block += '\n';
+    if (block.size() >= kFormatBlockSize) {
+      os.write(block.data(), block.size());
+      block.clear();
+    }
   }
+  os.write(block.data(), block.size());
   return os;
 }
 
 std::ostream& operator<<(std::ostream& os, const Point& point) {
-  os << std::setw(MAX_SIZE) << std::fixed << std::setprecision(MAX_PRECISION) << point.x << "\t"
-     << std::setw(MAX_SIZE) << std::fixed << std::setprecision(MAX_PRECISION) << point.y;
-
-  return os;
+  std::string text;
+  AppendPoint(text, point);
+  return os << text;
 }
 
 std::istream& operator>>(std::istream& is, PointVector& points) {
@@ -14,23 +14,65 @@
  * Referencias:
  */
 
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <random>
 #include <sstream>
 
+#include "cya/batch.h"
+#include "cya/binary_format.h"
+#include "cya/buffered_writer.h"
 #include "cya/cli.h"
+#include "cya/grid.h"
+#include "cya/kdtree.h"
+#include "cya/mapped_file.h"
 #include "cya/parser.h"
 #include "cya/point_types.h"
 #include "cya/pointset.h"
 #include "cya/program.h"
+#include "cya/scheduler.h"
+#include "cya/self_check.h"
+#include "cya/server.h"
 #include "mitata.h"
 
 namespace cya {
 
 static const std::string kDescription = R"(
   Uses the QuickHull algorithm to find the 
-  convex hull of a set of points.
+  convex hull of a set of points, or with --emst
+  its Euclidean minimum spanning tree.
+)";
+
+static const std::string kConvertDescription = R"(
+  Converts a point file between the text and the
+  binary point format.
+)";
+
+static const std::string kBatchDescription = R"(
+  Computes the convex hull of many point files on a
+  fixed pool of threads. The inputs are a glob pattern
+  or a manifest file with one input per line.
+)";
+
+static const std::string kServeDescription = R"(
+  Answers hull and EMST requests over a Unix domain
+  socket, or over stdin and stdout, without paying
+  the process startup on every request.
+)";
+
+static const std::string kLoadDescription = R"(
+  Sends the same request to a `cya serve` socket
+  many times and reports the latency percentiles.
+)";
+
+static const std::string kCheckDescription = R"(
+  Compares the EMST engines and the spatial indexes
+  with brute force on random inputs.
 )";
 
 static const std::string kExampleFile = R"(110
@@ -146,16 +188,126 @@ static const std::string kExampleFile = R"(110
 1980 1990
 )";
 
-std::string ReadFile(const std::string& filename) {
-  std::ifstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Could not open file: " + filename);
+namespace {
+
+constexpr size_t kForestBenchmarkSize = 10000;
+constexpr size_t kIndexBenchmarkSize = 100000;
+constexpr size_t kQueryBenchmarkSize = 10000;
+constexpr size_t kLocalityBenchmarkSize = 100000;
+// Bounds of the counts of `cya load` and `cya check`; both keep a result
+// per request or run every trial, so larger values are surely typos
+constexpr size_t kMaxLoadRequests = 100'000'000;
+constexpr size_t kMaxCheckTrials = 1'000'000;
+
+/**
+ * @brief Uniformly distributed points with a fixed seed, for benchmarks.
+ *
+ */
+PointVector RandomPoints(size_t count) {
+  std::mt19937 gen(count);
+  std::uniform_real_distribution<double> coordinate(-1e4, 1e4);
+  PointVector points(count);
+  for (Point& point : points) {
+    point = {coordinate(gen), coordinate(gen)};
+  }
+  return points;
+}
+
+/**
+ * @brief The same points with coordinates of another type, for benchmarks.
+ *
+ */
+template <typename PointT>
+std::vector<PointT> ConvertPoints(const PointVector& points) {
+  using Coordinate = CoordinateOf<PointT>;
+  std::vector<PointT> converted(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    converted[i] = {static_cast<Coordinate>(points[i].x), static_cast<Coordinate>(points[i].y)};
+  }
+  return converted;
+}
+
+/**
+ * @brief Replays the subtree merges EMST() performs for the given tree arcs,
+ * sorted by length, using `SubTreeT` as the forest storage.
+ */
+template <typename SubTreeT>
+void ReplayForest(const PointVector& points, const IndexTree& arcs) {
+  std::vector<SubTreeT> forest(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    forest[i].AddPoint(points[i]);
+  }
+  for (const IndexArc& indices : arcs) {
+    const Arc arc(points[indices.first], points[indices.second]);
+    size_t i = 0, j = 0;
+    for (size_t t = 0; t < forest.size(); ++t) {
+      i = forest[t].Contains(arc.first) ? t : i;
+      j = forest[t].Contains(arc.second) ? t : j;
+    }
+    forest[i].Merge(forest[j], {0.0, arc});
+    forest.erase(forest.begin() + j);
+  }
+}
+
+// Peak resident set size of the process; Linux reports ru_maxrss in KiB
+size_t PeakResidentBytes() {
+  struct rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) == -1) {
+    return 0;
+  }
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+// Messages go to stderr when the results are written to stdout
+std::ostream& ReportStream(const std::string& output_filename) {
+  return output_filename == kStandardStream ? std::cerr : std::cout;
+}
+
+// --threads and --affinity, shared by the commands that run parallel loops
+/**
+ * @brief Parses a count given on the command line, which must be a whole
+ * decimal number in [minimum, maximum]. Unlike std::stoul, signs, blanks,
+ * trailing characters and values out of range are rejected.
+ *
+ */
+size_t ParseCount(const std::string& value, size_t minimum, size_t maximum,
+                  const std::string& what) {
+  size_t count = 0;
+  const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+  if (error != std::errc() || end != value.data() + value.size() || count < minimum ||
+      count > maximum) {
+    throw std::runtime_error("Invalid " + what + ": " + value + ", expected an integer from " +
+                             std::to_string(minimum) + " to " + std::to_string(maximum));
+  }
+  return count;
+}
+
+// A size in MiB as bytes; the bound keeps the conversion from overflowing
+size_t ParseMebibytes(const std::string& value, const std::string& what) {
+  return ParseCount(value, 1, std::numeric_limits<size_t>::max() >> 20, what) << 20;
+}
+
+void AddSchedulerArguments(cli::ArgumentParser& cli, const std::string& threads_short_name) {
+  cli.AddArgument("threads", threads_short_name, "Threads to use, CYA_THREADS by default").End();
+  cli.AddArgument("affinity", "a", "Pin every thread to its own CPU")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+}
+
+void ConfigureScheduler(const cli::ArgumentParser& cli) {
+  size_t threads = 0;
+  if (cli.WasArgumentPassed("threads")) {
+    threads = ParseCount(
+        cli.GetValue<std::string>("threads"), 1, Scheduler::kMaxThreads, "thread count");
+  }
+  if (threads != 0 || cli.GetValue<bool>("affinity")) {
+    Scheduler::Configure(threads, cli.GetValue<bool>("affinity"));
   }
-  std::stringstream buffer;
-  buffer << file.rdbuf();
-  return buffer.str();
 }
 
+}  // namespace
+
 /**
  * @brief Runs the Program.
  *
@@ -164,17 +316,66 @@ std::string ReadFile(const std::string& filename) {
  * written to the output file.
  */
 void Program::Run() {
+  if (!arguments_.empty() && arguments_.front() == "convert") {
+    RunConvert();
+    return;
+  }
+  if (!arguments_.empty() && arguments_.front() == "batch") {
+    RunBatch();
+    return;
+  }
+  if (!arguments_.empty() && arguments_.front() == "serve") {
+    RunServe();
+    return;
+  }
+  if (!arguments_.empty() && arguments_.front() == "load") {
+    RunLoad();
+    return;
+  }
+  if (!arguments_.empty() && arguments_.front() == "check") {
+    RunCheck();
+    return;
+  }
+
   cli::ArgumentParser cli("cya", kDescription);
-  cli.AddPositionalArgument("input", "Input file").End();
-  cli.AddPositionalArgument("output", "Output file").End();
+  cli.AddPositionalArgument("input", "Input file, or - for stdin").End();
+  cli.AddPositionalArgument("output", "Output file, or - for stdout").End();
   cli.AddArgument("dot", "d", "Set output format to graphviz `.dot`")
       .SetFlag()
       .SetDefaultValue(false)
       .End();
+  cli.AddArgument("svg", "v", "Set output format to an already laid out `.svg`")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("lod", "l", "Decimate `.dot`/`.svg` output to this many pixels across").End();
   cli.AddArgument("order", "o", "Prints the order of a point").SetMultiple(2).End();
   cli.AddArgument("bench", "b", "Run benchmarks").SetFlag().SetDefaultValue(false).End();
   cli.AddArgument("improved", "i", "Use improved algorithm").SetFlag().SetDefaultValue(false).End();
   cli.AddArgument("random", "r", "Random hull").SetFlag().SetDefaultValue(false).End();
+  cli.AddArgument("clusters", "k", "Cut the EMST into this many single-linkage clusters").End();
+  cli.AddArgument("cut", "c", "Cut the EMST at this single-linkage distance").End();
+  cli.AddArgument("dendrogram", "g", "Write the single-linkage dendrogram")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("reorder", "s", "Sort points along a space-filling curve: hilbert or morton")
+      .End();
+  cli.AddArgument("binary", "y", "Write the output points in the binary point format")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("indices", "x", "Write the hull as binary point indices")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("stats", "t", "Print ingestion statistics")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("coordinates", "p", "Coordinate type: float64, float32 or int32").End();
+  cli.AddArgument("emst", "e", "Compute the EMST with kruskal, prim, multistart or sparse").End();
+  AddSchedulerArguments(cli, "n");
 
   try {
     cli.Parse(arguments_);
@@ -182,16 +383,270 @@ void Program::Run() {
     if (cli.IsHelpRequested()) {
       return;
     }
+    ConfigureScheduler(cli);
 
     const std::string& input_filename = cli.GetValue<std::string>("input");
     const std::string& output_filename = cli.GetValue<std::string>("output");
-    const std::string input = ReadFile(input_filename);
 
     if (cli.GetValue<bool>("bench")) {
       RunBenchmarks();
       return;
     }
-    ProcessInput(input, output_filename, cli);
+    ParseStats stats;
+    const std::string coordinates =
+        cli.WasArgumentPassed("coordinates") ? cli.GetValue<std::string>("coordinates") : "float64";
+    size_t point_count = 0;
+    if (coordinates == "float32") {
+      point_count = ProcessFile<PointF>(input_filename, output_filename, cli, &stats);
+    } else if (coordinates == "int32") {
+      point_count = ProcessFile<PointI>(input_filename, output_filename, cli, &stats);
+    } else if (coordinates == "float64") {
+      point_count = ProcessFile<Point>(input_filename, output_filename, cli, &stats);
+    } else {
+      throw std::runtime_error("Unknown coordinate type: " + coordinates);
+    }
+
+    if (cli.GetValue<bool>("stats")) {
+      std::ostream& report = ReportStream(output_filename);
+      report << "Points: " << point_count << std::endl;
+      report << "Input bytes: " << stats.input_bytes << std::endl;
+      report << "Bytes copied: " << stats.bytes_copied << std::endl;
+      report << "Peak RSS: " << PeakResidentBytes() << " bytes" << std::endl;
+    }
+  } catch (const cli::CliParserError& e) {
+    return;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief Runs `cya convert`, which translates a point file between the text
+ * and the binary format. The direction is given by the format of the input.
+ *
+ */
+void Program::RunConvert() {
+  cli::ArgumentParser cli("cya convert", kConvertDescription);
+  cli.AddPositionalArgument("input", "Input file, or - for stdin").End();
+  cli.AddPositionalArgument("output", "Output file, or - for stdout").End();
+  cli.AddArgument("layout", "l", "Binary coordinate layout: aos or soa").End();
+  cli.AddArgument("float32", "f", "Store binary coordinates as 32-bit floats")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("int32", "n", "Store binary coordinates as 32-bit integers")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  AddSchedulerArguments(cli, "");
+
+  try {
+    cli.Parse(std::vector<std::string>(arguments_.begin() + 1, arguments_.end()));
+
+    if (cli.IsHelpRequested()) {
+      return;
+    }
+    ConfigureScheduler(cli);
+
+    const std::string& input_filename = cli.GetValue<std::string>("input");
+    const std::string& output_filename = cli.GetValue<std::string>("output");
+    // The direction depends on the raw input, so stdin and pipes are read whole
+    MappedFile file;
+    std::string piped;
+    if (input_filename == kStandardStream) {
+      piped.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else if (!MappedFile::IsRegularFile(input_filename)) {
+      std::ifstream stream(input_filename, std::ios::binary);
+      if (!stream) {
+        throw std::runtime_error("Could not open file: " + input_filename);
+      }
+      piped.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    } else {
+      file = MappedFile(input_filename);
+    }
+    const std::string_view input = file.size() > 0 ? file.GetView() : piped;
+    auto points_result = PointParser<>::ParseFromBuffer(input);
+    if (!points_result) {
+      throw std::runtime_error(std::string("Error parsing points: ") +
+                               points_result.error().what());
+    }
+
+    if (IsBinaryPoints(input)) {
+      WriteTextPoints(output_filename, points_result.value());
+      return;
+    }
+    const Layout layout =
+        cli.WasArgumentPassed("layout") ? ParseLayout(cli.GetValue<std::string>("layout")) : AOS;
+    const CoordinateType type = cli.GetValue<bool>("int32")     ? INT32
+                                : cli.GetValue<bool>("float32") ? FLOAT32
+                                                                : FLOAT64;
+    WriteBinaryPoints(output_filename, points_result.value(), layout, type);
+  } catch (const cli::CliParserError& e) {
+    return;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief Runs `cya batch`, which writes the hull of every input to its own
+ * file in the output directory and prints the aggregate throughput.
+ *
+ */
+void Program::RunBatch() {
+  cli::ArgumentParser cli("cya batch", kBatchDescription);
+  cli.AddPositionalArgument("inputs", "Glob pattern or manifest of input files").End();
+  cli.AddPositionalArgument("output", "Output directory").End();
+  cli.AddArgument("jobs", "j", "Files processed at the same time").End();
+  cli.AddArgument("memory", "m", "Memory budget of the running jobs in MiB").End();
+  cli.AddArgument("improved", "i", "Use improved algorithm").SetFlag().SetDefaultValue(false).End();
+  cli.AddArgument("binary", "y", "Write the hulls in the binary point format")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  AddSchedulerArguments(cli, "n");
+
+  try {
+    cli.Parse(std::vector<std::string>(arguments_.begin() + 1, arguments_.end()));
+
+    if (cli.IsHelpRequested()) {
+      return;
+    }
+    ConfigureScheduler(cli);
+
+    // Each job runs its file on one thread, so the jobs are the threads
+    BatchOptions options;
+    options.jobs = Scheduler::Global().size();
+    if (cli.WasArgumentPassed("jobs")) {
+      options.jobs = ParseCount(
+          cli.GetValue<std::string>("jobs"), 1, Scheduler::kMaxThreads, "job count");
+    }
+    if (cli.WasArgumentPassed("memory")) {
+      options.memory_budget = ParseMebibytes(cli.GetValue<std::string>("memory"), "memory budget");
+    }
+    options.improved = cli.GetValue<bool>("improved");
+    options.format = cli.GetValue<bool>("binary") ? BINARY : TEXT;
+
+    const std::string& output_dir = cli.GetValue<std::string>("output");
+    const std::vector<std::string> inputs = ExpandInputs(cli.GetValue<std::string>("inputs"));
+    const std::vector<std::string> outputs = BatchOutputNames(inputs, output_dir, options.format);
+    std::filesystem::create_directories(output_dir);
+
+    const BatchSummary summary = cya::RunBatch(inputs, outputs, options, std::cerr);
+    const double seconds = std::max(summary.seconds, 1e-9);
+    std::cout << "Files: " << summary.files << " (" << summary.failed << " failed)" << std::endl;
+    std::cout << "Points: " << summary.points << std::endl;
+    std::cout << "Time: " << summary.seconds << " s" << std::endl;
+    std::cout << "Files/s: " << summary.files / seconds << std::endl;
+    std::cout << "Points/s: " << summary.points / seconds << std::endl;
+  } catch (const cli::CliParserError& e) {
+    return;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief Runs `cya serve`, which answers requests until the process is
+ * stopped, or until stdin is closed with `--stdio`.
+ *
+ */
+void Program::RunServe() {
+  cli::ArgumentParser cli("cya serve", kServeDescription);
+  cli.AddPositionalArgument("socket", "Unix domain socket path")
+      .SetDefaultValue(std::string())
+      .End();
+  cli.AddArgument("stdio", "s", "Serve a single client over stdin and stdout")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+  cli.AddArgument("workers", "w", "Requests answered at the same time").End();
+  cli.AddArgument("max-payload", "m", "Largest request accepted, in MiB").End();
+  AddSchedulerArguments(cli, "n");
+
+  try {
+    cli.Parse(std::vector<std::string>(arguments_.begin() + 1, arguments_.end()));
+
+    if (cli.IsHelpRequested()) {
+      return;
+    }
+    ConfigureScheduler(cli);
+
+    size_t max_payload = kDefaultMaxPayload;
+    if (cli.WasArgumentPassed("max-payload")) {
+      max_payload = ParseMebibytes(cli.GetValue<std::string>("max-payload"), "payload size");
+    }
+    if (cli.GetValue<bool>("stdio")) {
+      Server::ServeConnection(STDIN_FILENO, STDOUT_FILENO, max_payload);
+      return;
+    }
+    const std::string& path = cli.GetValue<std::string>("socket");
+    if (path.empty()) {
+      throw std::runtime_error("A socket path or --stdio is needed");
+    }
+    // Each request is answered on one thread, so the workers are the threads
+    size_t workers = Scheduler::Global().size();
+    if (cli.WasArgumentPassed("workers")) {
+      workers = ParseCount(
+          cli.GetValue<std::string>("workers"), 1, Scheduler::kMaxThreads, "worker count");
+    }
+    Server server(workers, max_payload);
+    server.ServeSocket(path);
+  } catch (const cli::CliParserError& e) {
+    return;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+  }
+}
+
+/**
+ * @brief Runs `cya load`, the load generator for `cya serve`.
+ *
+ */
+void Program::RunLoad() {
+  cli::ArgumentParser cli("cya load", kLoadDescription);
+  cli.AddPositionalArgument("socket", "Unix domain socket path").End();
+  cli.AddPositionalArgument("input", "Points sent with every request").End();
+  cli.AddArgument("requests", "n", "Amount of requests").End();
+  cli.AddArgument("connections", "c", "Concurrent connections").End();
+  cli.AddArgument("emst", "e", "Request the EMST instead of the hull")
+      .SetFlag()
+      .SetDefaultValue(false)
+      .End();
+
+  try {
+    cli.Parse(std::vector<std::string>(arguments_.begin() + 1, arguments_.end()));
+
+    if (cli.IsHelpRequested()) {
+      return;
+    }
+
+    size_t requests = 1000;
+    size_t connections = 1;
+    if (cli.WasArgumentPassed("requests")) {
+      requests = ParseCount(
+          cli.GetValue<std::string>("requests"), 1, kMaxLoadRequests, "amount of requests");
+    }
+    if (cli.WasArgumentPassed("connections")) {
+      connections = ParseCount(cli.GetValue<std::string>("connections"), 1,
+                               Scheduler::kMaxThreads, "amount of connections");
+    }
+    auto points_result = ParsePointsFromFile(cli.GetValue<std::string>("input"));
+    if (!points_result) {
+      throw std::runtime_error(std::string("Error parsing points: ") +
+                               points_result.error().what());
+    }
+
+    const RequestKind kind = cli.GetValue<bool>("emst") ? EMST_REQUEST : HULL_REQUEST;
+    const LoadSummary summary = cya::RunLoad(
+        cli.GetValue<std::string>("socket"), points_result.value(), kind, requests, connections);
+    std::cout << "Requests: " << summary.requests << " (" << summary.failed << " failed)"
+              << std::endl;
+    std::cout << "Requests/s: " << summary.requests / std::max(summary.seconds, 1e-9)
+              << std::endl;
+    std::cout << "p50: " << summary.Percentile(0.50) * 1e6 << " us" << std::endl;
+    std::cout << "p99: " << summary.Percentile(0.99) * 1e6 << " us" << std::endl;
+    std::cout << "Max: " << summary.Percentile(1.0) * 1e6 << " us" << std::endl;
   } catch (const cli::CliParserError& e) {
     return;
   } catch (const std::exception& e) {
@@ -199,6 +654,46 @@ void Program::Run() {
   }
 }
 
+/**
+ * @brief Runs `cya check`, the comparison of the engines with brute force.
+ * Failed checks are reported and make the program exit with an error.
+ *
+ */
+void Program::RunCheck() {
+  cli::ArgumentParser cli("cya check", kCheckDescription);
+  cli.AddArgument("trials", "t", "Random inputs per check").End();
+  cli.AddArgument("seed", "s", "Seed of the random inputs").End();
+
+  CheckSummary summary;
+  try {
+    cli.Parse(std::vector<std::string>(arguments_.begin() + 1, arguments_.end()));
+
+    if (cli.IsHelpRequested()) {
+      return;
+    }
+
+    CheckOptions options;
+    if (cli.WasArgumentPassed("trials")) {
+      options.trials =
+          ParseCount(cli.GetValue<std::string>("trials"), 1, kMaxCheckTrials, "amount of trials");
+    }
+    if (cli.WasArgumentPassed("seed")) {
+      options.seed = ParseCount(cli.GetValue<std::string>("seed"), 0,
+                                std::numeric_limits<size_t>::max(), "seed");
+    }
+    summary = RunSelfChecks(options, std::cout);
+    std::cout << summary.passed << " passed, " << summary.failed << " failed" << std::endl;
+  } catch (const cli::CliParserError& e) {
+    return;
+  } catch (const std::exception& e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return;
+  }
+  if (summary.failed > 0) {
+    throw std::runtime_error("Some checks failed.");
+  }
+}
+
 void Program::RunBenchmarks() {
   auto points_result = ParsePointsFromString(kExampleFile);
   if (!points_result) {
@@ -212,24 +707,131 @@ void Program::RunBenchmarks() {
     runner.bench("Normal", [&]() { Process(points); });
     runner.bench("Improved", [&]() { ProcessImproved(points); });
   });
+  runner.summary([&]() {
+    for (const std::string engine : {"kruskal", "prim", "multistart", "sparse"}) {
+      runner.bench("EMST " + engine, [&, engine]() { ProcessEMST(points, engine); });
+    }
+  });
+
+  const PointVector cloud = RandomPoints(kForestBenchmarkSize);
+  PointSet cloud_set(cloud);
+  cloud_set.EMSTSparse();
+  IndexTree arcs = cloud_set.GetIndexTree();
+  std::sort(arcs.begin(), arcs.end(), [&](const IndexArc& a, const IndexArc& b) {
+    const Point da = cloud[a.first] - cloud[a.second];
+    const Point db = cloud[b.first] - cloud[b.second];
+    return da * da < db * db;
+  });
+
+  runner.summary([&]() {
+    runner.bench("SubTree std::set (1e4)", [&]() { ReplayForest<OrderedSubTree>(cloud, arcs); });
+    runner.bench("SubTree flat hash (1e4)", [&]() { ReplayForest<SubTree>(cloud, arcs); });
+  });
+
+  const PointVector index_points = RandomPoints(kIndexBenchmarkSize);
+  const PointVector queries = RandomPoints(kQueryBenchmarkSize);
+  const KdTree kd_tree(index_points);
+  const UniformGrid grid(index_points);
+  std::vector<size_t> offsets;
+  std::vector<PointIndex> found;
+
+  runner.summary([&]() {
+    runner.bench("k-d tree build (1e5)", [&]() { KdTree tree(index_points); });
+    runner.bench("Grid build (1e5)", [&]() { UniformGrid index(index_points); });
+  });
+  runner.summary([&]() {
+    runner.bench("k-d tree nearest (1e4 queries)", [&]() { kd_tree.Nearest(queries); });
+    runner.bench("k-d tree 16-NN (1e4 queries)", [&]() { kd_tree.KNearest(queries, 16); });
+    runner.bench("k-d tree radius (1e4 queries)",
+                 [&]() { kd_tree.Radius(queries, 100.0, offsets, found); });
+    runner.bench("Grid nearest (1e4 queries)", [&]() { grid.Nearest(queries); });
+    runner.bench("Grid 16-NN (1e4 queries)", [&]() { grid.KNearest(queries, 16); });
+  });
+
+  PointSet file_order(RandomPoints(kLocalityBenchmarkSize));
+  PointSet morton_order = file_order;
+  morton_order.SpatialReorder(MORTON);
+  PointSet hilbert_order = file_order;
+  hilbert_order.SpatialReorder(HILBERT);
+
+  runner.summary([&]() {
+    runner.bench("EMSTSparse file order (1e5)", [&]() { file_order.EMSTSparse(); });
+    runner.bench("EMSTSparse Morton order (1e5)", [&]() { morton_order.EMSTSparse(); });
+    runner.bench("EMSTSparse Hilbert order (1e5)", [&]() { hilbert_order.EMSTSparse(); });
+  });
+
+  const std::vector<PointF> float_points = ConvertPoints<PointF>(index_points);
+  const std::vector<PointI> integer_points = ConvertPoints<PointI>(index_points);
+
+  runner.summary([&]() {
+    runner.bench("Hull float64 (1e5)", [&]() { ProcessImproved(index_points); });
+    runner.bench("Hull float32 (1e5)", [&]() { ProcessImproved(float_points); });
+    runner.bench("Hull int32 (1e5)", [&]() { ProcessImproved(integer_points); });
+  });
+  runner.summary([&]() {
+    runner.bench("EMST float64 (1e5)", [&]() { ProcessEMST(index_points, "sparse"); });
+    runner.bench("EMST float32 (1e5)", [&]() { ProcessEMST(float_points, "sparse"); });
+    runner.bench("EMST int32 (1e5)", [&]() { ProcessEMST(integer_points, "sparse"); });
+  });
 
   auto stats = runner.run();
 }
 
-void Program::ProcessInput(const std::string& input, const std::string& output_filename,
-                           const cli::ArgumentParser& cli) {
-  auto points_result = ParsePointsFromString(input);
+/**
+ * @brief Reads the input with coordinates of type PointT and processes it.
+ *
+ * @return Amount of points read.
+ */
+template <typename PointT>
+size_t Program::ProcessFile(const std::string& input_filename, const std::string& output_filename,
+                            const cli::ArgumentParser& cli, ParseStats* stats) {
+  auto points_result = PointParser<PointT>::ParseFromFile(input_filename, stats);
   if (!points_result) {
     throw std::runtime_error(std::string("Error parsing points: ") + points_result.error().what());
   }
-  const PointVector& points = points_result.value();
-  std::optional<PointSet> processed_points;
-  if (cli.GetValue<bool>("improved")) {
-    processed_points = ProcessImproved(points);
+  const size_t point_count = points_result->size();
+  // The parsed points are moved all the way into the PointSet
+  ProcessInput(std::move(points_result).value(), output_filename, cli);
+  return point_count;
+}
+
+template <typename PointT>
+void Program::ProcessInput(std::vector<PointT> points, const std::string& output_filename,
+                           const cli::ArgumentParser& cli) {
+  if (cli.WasArgumentPassed("clusters") || cli.WasArgumentPassed("cut") ||
+      cli.GetValue<bool>("dendrogram")) {
+    ProcessClusters(std::move(points), output_filename, cli);
+    return;
+  }
+
+  const bool emst = cli.WasArgumentPassed("emst");
+  if (emst && (cli.GetValue<bool>("improved") || cli.GetValue<bool>("random"))) {
+    throw std::runtime_error("--emst can not be combined with --improved or --random");
+  }
+  if (emst && cli.GetValue<bool>("binary")) {
+    throw std::runtime_error("--emst writes the tree as text or, with --indices, as indices");
+  }
+
+  // Sorting along a curve only pays off for the neighbor queries of the EMST
+  std::optional<Curve> curve;
+  if (cli.WasArgumentPassed("reorder")) {
+    if (!emst) {
+      throw std::runtime_error("--reorder needs --emst or one of the clustering options");
+    }
+    curve = ParseCurve(cli.GetValue<std::string>("reorder"));
+  }
+
+  std::optional<BasicPointSet<PointT>> processed_points;
+  if (emst) {
+    processed_points = ProcessEMST(std::move(points), cli.GetValue<std::string>("emst"), curve);
+    ReportStream(output_filename) << "EMST cost: " << processed_points.value().GetCost()
+                                  << std::endl;
+  } else if (cli.GetValue<bool>("improved")) {
+    processed_points = ProcessImproved(std::move(points));
   } else if (cli.GetValue<bool>("random")) {
     processed_points = ProcessRandom(points);
   } else {
-    processed_points = Process(points);
+    processed_points = Process(std::move(points));
   }
 
   if (cli.WasArgumentPassed("order")) {
@@ -246,39 +848,130 @@ void Program::ProcessInput(const std::string& input, const std::string& output_f
       }
     }
 
-    Point point = {static_cast<double>(point_vector_double[0]),
-                   static_cast<double>(point_vector_double[1])};
-    std::cout << "Order of point " << point.x << ", " << point.y << ": "
-              << processed_points.value().GetPointOrder(point) << std::endl;
+    using Coordinate = CoordinateOf<PointT>;
+    const PointT point = {static_cast<Coordinate>(point_vector_double[0]),
+                          static_cast<Coordinate>(point_vector_double[1])};
+    ReportStream(output_filename) << "Order of point " << point.x << ", " << point.y << ": "
+                                  << processed_points.value().GetPointOrder(point) << std::endl;
   }
 
-  if (cli.GetValue<bool>("dot")) {
-    processed_points.value().WriteDot(output_filename);
+  if (cli.GetValue<bool>("dot") || cli.GetValue<bool>("svg")) {
+    const GraphFormat format = cli.GetValue<bool>("svg") ? SVG : DOT;
+    if (!cli.WasArgumentPassed("lod")) {
+      processed_points.value().WriteGraph(output_filename, format);
+      return;
+    }
+    // Resolutions above what WriteDecimatedGraph draws are clamped there
+    const size_t resolution = ParseCount(cli.GetValue<std::string>("lod"), 1,
+                                         std::numeric_limits<size_t>::max(), "resolution");
+    processed_points.value().WriteDecimatedGraph(output_filename, format, resolution);
+    return;
+  }
+  if (cli.GetValue<bool>("indices")) {
+    processed_points.value().WriteIndices(output_filename, emst ? TREE_INDICES : HULL_INDICES);
     return;
   }
-  processed_points.value().Write(output_filename);
+  if (emst) {
+    processed_points.value().WriteTree(output_filename);
+    return;
+  }
+  processed_points.value().Write(output_filename, cli.GetValue<bool>("binary") ? BINARY : TEXT);
 }
 
-PointSet Program::Process(const PointVector& points) {
-  PointSet point_set(points);
+template <typename PointT>
+void Program::ProcessClusters(std::vector<PointT> points, const std::string& output_filename,
+                              const cli::ArgumentParser& cli) {
+  BasicPointSet<PointT> point_set(std::move(points));
+  if (cli.WasArgumentPassed("reorder")) {
+    point_set.SpatialReorder(ParseCurve(cli.GetValue<std::string>("reorder")));
+  }
+  point_set.EMSTSparse();
+
+  if (cli.GetValue<bool>("dendrogram")) {
+    point_set.WriteDendrogram(output_filename, point_set.ComputeDendrogram());
+    return;
+  }
+
+  ClusterLabels labels;
+  if (cli.WasArgumentPassed("cut")) {
+    const std::string value = cli.GetValue<std::string>("cut");
+    double threshold;
+    try {
+      threshold = std::stod(value);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("Invalid distance value: " + value);
+    }
+    labels = point_set.ClusterByDistance(threshold);
+  } else {
+    const size_t clusters = ParseCount(cli.GetValue<std::string>("clusters"), 1,
+                                       std::numeric_limits<PointIndex>::max(), "cluster count");
+    labels = point_set.ClusterByCount(clusters);
+  }
+  point_set.WriteClusters(output_filename, labels);
+}
+
+template <typename PointT>
+BasicPointSet<PointT> Program::Process(std::vector<PointT> points) {
+  BasicPointSet<PointT> point_set(std::move(points));
   point_set.QuickHull();
   return point_set;
 }
 
-PointSet Program::ProcessImproved(const PointVector& points) {
-  PointSet point_set(points);
+template <typename PointT>
+BasicPointSet<PointT> Program::ProcessImproved(std::vector<PointT> points) {
+  BasicPointSet<PointT> point_set(std::move(points));
   point_set.QuickHullImproved();
   return point_set;
 }
 
-PointSet Program::ProcessRandom(const PointVector& points) {
+/**
+ * @brief EMST of the points with one of the PointSet engines: kruskal
+ * (EMST), prim (EMSTImproved), multistart (EMSTMultistart) or sparse
+ * (EMSTSparse), after sorting them along `curve` if one is given.
+ *
+ */
+template <typename PointT>
+BasicPointSet<PointT> Program::ProcessEMST(std::vector<PointT> points, const std::string& engine,
+                                           std::optional<Curve> curve) {
+  if (engine == "multistart") {
+    return ProcessMultistart(points, curve);
+  }
+  BasicPointSet<PointT> point_set(std::move(points));
+  if (curve) {
+    point_set.SpatialReorder(*curve);
+  }
+  if (engine == "kruskal") {
+    point_set.EMST();
+  } else if (engine == "prim") {
+    point_set.EMSTImproved();
+  } else if (engine == "sparse") {
+    point_set.EMSTSparse();
+  } else {
+    throw std::runtime_error("Unknown EMST engine: " + engine);
+  }
+  return point_set;
+}
+
+template <typename PointT>
+BasicPointSet<PointT> Program::ProcessMultistart(const std::vector<PointT>& points,
+                                                 std::optional<Curve> curve) {
+  BasicPointSet<PointT> point_set(points);
+  if (curve) {
+    point_set.SpatialReorder(*curve);
+  }
+  point_set.EMSTMultistart();
+  return point_set;
+}
+
+template <typename PointT>
+BasicPointSet<PointT> Program::ProcessRandom(const std::vector<PointT>& points) {
   auto new_points = points;
   std::random_device rd;
   std::mt19937 gen(rd());
   std::shuffle(new_points.begin(), new_points.end(), gen);
   new_points.resize(new_points.size() / 2);
 
-  PointSet point_set(new_points);
+  BasicPointSet<PointT> point_set(new_points);
   point_set.QuickHull();
   point_set.clear();
   point_set.insert(point_set.end(), points.begin(), points.end());
@@ -0,0 +1,90 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo radix_sort.cc: Implementación de la ordenación radix
+ * Referencias:
+ */
+
+#include <algorithm>
+#include <array>
+
+#include "cya/parallel.h"
+#include "cya/radix_sort.h"
+
+namespace cya {
+
+namespace {
+
+constexpr int kDigitBits = 8;
+constexpr int kBuckets = 1 << kDigitBits;
+constexpr int kPasses = 64 / kDigitBits;
+constexpr size_t kSmallSort = 1 << 10;
+
+}  // namespace
+
+void RadixSort(std::vector<RadixRecord>& records) {
+  const size_t n = records.size();
+  if (n < kSmallSort) {
+    std::stable_sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+      return a.key < b.key;
+    });
+    return;
+  }
+
+  const size_t chunks = ParallelChunkCount(n);
+  std::vector<RadixRecord> buffer(n);
+  std::vector<std::array<size_t, kBuckets>> counts(chunks);
+  RadixRecord* source = records.data();
+  RadixRecord* target = buffer.data();
+
+  for (int pass = 0; pass < kPasses; ++pass) {
+    const int shift = pass * kDigitBits;
+
+    ParallelChunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      counts[chunk].fill(0);
+      for (size_t i = begin; i < end; ++i) {
+        ++counts[chunk][(source[i].key >> shift) & (kBuckets - 1)];
+      }
+    });
+
+    // Exclusive prefix sum in (digit, chunk) order keeps the sort stable
+    size_t offset = 0;
+    bool uniform = false;
+    for (int digit = 0; digit < kBuckets && !uniform; ++digit) {
+      size_t bucket_total = 0;
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        const size_t count = counts[chunk][digit];
+        counts[chunk][digit] = offset;
+        offset += count;
+        bucket_total += count;
+      }
+      uniform = bucket_total == n;
+    }
+    if (uniform) {
+      continue;
+    }
+
+    ParallelChunks(n, chunks, [&](size_t chunk, size_t begin, size_t end) {
+      auto& next = counts[chunk];
+      for (size_t i = begin; i < end; ++i) {
+        target[next[(source[i].key >> shift) & (kBuckets - 1)]++] = source[i];
+      }
+    });
+    std::swap(source, target);
+  }
+
+  if (source != records.data()) {
+    records.swap(buffer);
+  }
+}
+
+}  // namespace cya
@@ -0,0 +1,210 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo scheduler.cc: Implementación del planificador global
+ * Referencias:
+ */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "cya/scheduler.h"
+
+namespace cya {
+
+namespace {
+
+// Set on threads whose parallel loops must run inline: the scheduler workers,
+// the ThreadPool workers and a caller while its loop is running
+thread_local bool inline_loops = false;
+
+std::mutex global_mutex;
+std::unique_ptr<Scheduler> global_scheduler;
+
+// CPUs the process may run on, in increasing order
+std::vector<int> AllowedCpus() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    throw std::runtime_error("Could not read the CPU affinity: " +
+                             std::string(std::strerror(errno)));
+  }
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// Binds the calling thread to `cpu` and returns the error number, or 0
+int PinThread(int cpu) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+}  // namespace
+
+Scheduler::Scheduler(size_t threads, bool pin) {
+  threads = std::max<size_t>(threads, 1);
+  if (pin) {
+    const std::vector<int> allowed = AllowedCpus();
+    for (size_t i = 0; i < threads; ++i) {
+      cpus_.push_back(allowed[i % allowed.size()]);
+    }
+    if (const int error = PinThread(cpus_.front()); error != 0) {
+      throw std::runtime_error("Could not pin to CPU " + std::to_string(cpus_.front()) + ": " +
+                               std::strerror(error));
+    }
+  }
+  workers_.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i) {
+    workers_.emplace_back(&Scheduler::WorkerLoop, this, i);
+  }
+}
+
+Scheduler::~Scheduler() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+Scheduler& Scheduler::Global() {
+  std::lock_guard lock(global_mutex);
+  if (!global_scheduler) {
+    global_scheduler = std::make_unique<Scheduler>(DefaultThreadCount(), false);
+  }
+  return *global_scheduler;
+}
+
+void Scheduler::Configure(size_t threads, bool pin) {
+  std::lock_guard lock(global_mutex);
+  global_scheduler.reset();
+  global_scheduler =
+      std::make_unique<Scheduler>(threads == 0 ? DefaultThreadCount() : threads, pin);
+}
+
+size_t Scheduler::DefaultThreadCount() {
+  if (const char* variable = std::getenv("CYA_THREADS"); variable != nullptr) {
+    const std::string_view text = variable;
+    size_t threads = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), threads);
+    if (error != std::errc() || end != text.data() + text.size() || threads == 0 ||
+        threads > kMaxThreads) {
+      throw std::runtime_error("CYA_THREADS must be an integer from 1 to " +
+                               std::to_string(kMaxThreads) + ", not \"" + std::string(text) +
+                               "\"");
+    }
+    return threads;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Scheduler::MarkWorkerThread() { inline_loops = true; }
+
+void Scheduler::Run(size_t tasks, const std::function<void(size_t)>& function) {
+  std::unique_lock running(run_mutex_, std::defer_lock);
+  if (tasks <= 1 || workers_.empty() || inline_loops || !running.try_lock()) {
+    for (size_t task = 0; task < tasks; ++task) {
+      function(task);
+    }
+    return;
+  }
+
+  {
+    std::unique_lock lock(mutex_);
+    // Workers that woke late for the previous loop must leave it first
+    done_.wait(lock, [this] { return active_ == 0; });
+    job_ = &function;
+    tasks_ = tasks;
+    next_ = 0;
+    error_ = nullptr;
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  inline_loops = true;
+  Work();
+  inline_loops = false;
+
+  std::exception_ptr error;
+  {
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    error = std::exchange(error_, nullptr);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void Scheduler::WorkerLoop(size_t index) {
+  inline_loops = true;
+  // The caller was pinned already, so a failure here is unlikely and only
+  // costs locality
+  if (!cpus_.empty()) {
+    PinThread(cpus_[index]);
+  }
+  std::uint64_t seen = 0;
+  std::unique_lock lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+    if (stopping_) {
+      return;
+    }
+    seen = generation_;
+    ++active_;
+    lock.unlock();
+    Work();
+    lock.lock();
+    if (--active_ == 0) {
+      done_.notify_all();
+    }
+  }
+}
+
+void Scheduler::Work() {
+  while (true) {
+    const size_t task = next_.fetch_add(1);
+    if (task >= tasks_) {
+      return;
+    }
+    try {
+      (*job_)(task);
+    } catch (...) {
+      std::lock_guard lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+}  // namespace cya
@@ -0,0 +1,681 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo self_check.cc: Implementación de las comprobaciones contra fuerza bruta
+ * Referencias:
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "cya/binary_format.h"
+#include "cya/disjoint_set.h"
+#include "cya/geometry.h"
+#include "cya/grid.h"
+#include "cya/kdtree.h"
+#include "cya/parser.h"
+#include "cya/pointset.h"
+#include "cya/self_check.h"
+
+namespace cya {
+
+namespace {
+
+// Points per random input; EMST() is quadratic, so inputs stay small
+constexpr size_t kMaxCheckPoints = 300;
+// Text size of the chunked parsing inputs, several chunks and stream blocks
+constexpr size_t kChunkedCheckBytes = 6 << 20;
+
+enum Distribution { UNIFORM, CLUSTERED, LATTICE };
+
+// One random case of a check: the reason it failed, or empty if it passed
+using CheckTrial = std::function<std::string(std::mt19937_64& rng)>;
+
+struct Check {
+  std::string name;
+  CheckTrial trial;
+};
+
+/**
+ * @brief Random input of up to kMaxCheckPoints points. Clustered inputs are
+ * tight clouds far from each other, where nearest neighbors never leave their
+ * cloud; lattice inputs have duplicates and collinear points.
+ */
+template <typename PointT>
+std::vector<PointT> RandomPoints(std::mt19937_64& rng, Distribution distribution) {
+  using Coordinate = CoordinateOf<PointT>;
+  std::uniform_int_distribution<size_t> count(2, kMaxCheckPoints);
+  std::uniform_real_distribution<double> spread(-1e4, 1e4);
+  std::normal_distribution<double> noise(0.0, 10.0);
+  std::uniform_int_distribution<int> lattice(0, 15);
+
+  std::vector<Point> centers(std::uniform_int_distribution<size_t>(1, 8)(rng));
+  for (Point& center : centers) {
+    center = {spread(rng), spread(rng)};
+  }
+  std::uniform_int_distribution<size_t> cluster(0, centers.size() - 1);
+
+  std::vector<PointT> points(count(rng));
+  for (PointT& point : points) {
+    Point sample;
+    if (distribution == UNIFORM) {
+      sample = {spread(rng), spread(rng)};
+    } else if (distribution == CLUSTERED) {
+      const Point& center = centers[cluster(rng)];
+      sample = {center.x + noise(rng), center.y + noise(rng)};
+    } else {
+      sample = {double(lattice(rng)), double(lattice(rng))};
+    }
+    if constexpr (std::is_integral_v<Coordinate>) {
+      sample = {std::round(sample.x), std::round(sample.y)};
+    }
+    point = {Coordinate(sample.x), Coordinate(sample.y)};
+  }
+  return points;
+}
+
+std::string Mismatch(const std::string& what, double value, double expected) {
+  std::ostringstream message;
+  message.precision(17);
+  message << what << " is " << value << " instead of " << expected;
+  return message.str();
+}
+
+bool SameLength(double value, double expected) {
+  return std::abs(value - expected) <= 1e-9 * std::max(1.0, std::abs(expected));
+}
+
+/**
+ * @brief Cost of the EMST by Kruskal over every pair of points by index.
+ * EMST() finds subtrees by coordinates, so it is no reference for inputs with
+ * duplicate points.
+ */
+template <typename PointT>
+double BruteForceEMSTCost(const std::vector<PointT>& points) {
+  std::vector<std::pair<double, IndexArc>> arcs;
+  for (PointIndex i = 0; i < points.size(); ++i) {
+    for (PointIndex j = i + 1; j < points.size(); ++j) {
+      const double dx = static_cast<double>(points[i].x) - points[j].x;
+      const double dy = static_cast<double>(points[i].y) - points[j].y;
+      arcs.push_back({std::sqrt(dx * dx + dy * dy), {i, j}});
+    }
+  }
+  std::sort(arcs.begin(), arcs.end());
+  DisjointSet components(points.size());
+  double cost = 0.0;
+  for (const auto& [length, arc] : arcs) {
+    if (components.Union(arc.first, arc.second)) {
+      cost += length;
+    }
+  }
+  return cost;
+}
+
+// Checks that `point_set` holds a spanning tree as cheap as the EMST
+template <typename PointT>
+std::string CompareWithEMST(const BasicPointSet<PointT>& point_set, double expected_cost) {
+  const size_t arcs = point_set.GetIndexTree().size();
+  if (arcs != point_set.size() - 1) {
+    return Mismatch("Arc count", arcs, point_set.size() - 1);
+  }
+  if (!SameLength(point_set.GetCost(), expected_cost)) {
+    return Mismatch("EMST cost", point_set.GetCost(), expected_cost);
+  }
+  return "";
+}
+
+/**
+ * @brief EMSTSparse against brute force and, on inputs without duplicates,
+ * against EMST(). Trees may differ on ties, so the costs are compared.
+ *
+ */
+template <typename PointT>
+std::string CheckSparseEMST(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  BasicPointSet<PointT> sparse(points);
+  sparse.EMSTSparse();
+  const double expected_cost = BruteForceEMSTCost(points);
+  if (distribution != LATTICE) {
+    BasicPointSet<PointT> exact(points);
+    exact.EMST();
+    if (!SameLength(exact.GetCost(), expected_cost)) {
+      return Mismatch("EMST() cost", exact.GetCost(), expected_cost);
+    }
+  }
+  return CompareWithEMST(sparse, expected_cost);
+}
+
+/**
+ * @brief The EMST of a prefix of the points grown by AddPoints() in a few
+ * batches, against the EMST of all of them.
+ *
+ */
+template <typename PointT>
+std::string CheckAddPoints(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  std::uniform_int_distribution<size_t> cut(0, points.size());
+  std::vector<size_t> cuts{cut(rng), cut(rng), cut(rng)};
+  std::sort(cuts.begin(), cuts.end());
+
+  BasicPointSet<PointT> grown(std::vector<PointT>(points.begin(), points.begin() + cuts[0]));
+  grown.EMSTSparse();
+  for (size_t batch = 0; batch < cuts.size(); ++batch) {
+    const size_t end = batch + 1 < cuts.size() ? cuts[batch + 1] : points.size();
+    grown.AddPoints(std::vector<PointT>(points.begin() + cuts[batch], points.begin() + end));
+  }
+  const double expected_cost = BruteForceEMSTCost(points);
+  if (distribution != LATTICE) {
+    BasicPointSet<PointT> exact(points);
+    exact.EMST();
+    if (!SameLength(exact.GetCost(), expected_cost)) {
+      return Mismatch("EMST() cost", exact.GetCost(), expected_cost);
+    }
+  }
+  return CompareWithEMST(grown, expected_cost);
+}
+
+template <typename PointT>
+std::string CheckOctants(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  const BasicKdTree<PointT> tree(points);
+  const double infinity = std::numeric_limits<double>::infinity();
+  for (PointIndex i = 0; i < points.size(); ++i) {
+    OctantNeighbors best;
+    best.fill({infinity, i});
+    tree.NearestInOctants(points[i], i, best);
+
+    // Ties go to the lowest index, which makes the answer unique
+    OctantNeighbors expected;
+    expected.fill({infinity, i});
+    for (PointIndex j = 0; j < points.size(); ++j) {
+      const double dx = static_cast<double>(points[j].x) - points[i].x;
+      const double dy = static_cast<double>(points[j].y) - points[i].y;
+      const Neighbor candidate{dx * dx + dy * dy, j};
+      Neighbor& slot = expected[Octant(dx, dy)];
+      if (j != i && candidate < slot) {
+        slot = candidate;
+      }
+    }
+    for (size_t slot = 0; slot < best.size(); ++slot) {
+      if (best[slot] != expected[slot]) {
+        return Mismatch("Octant " + std::to_string(slot) + " neighbor of point " +
+                            std::to_string(i),
+                        best[slot].second, expected[slot].second);
+      }
+    }
+  }
+  return "";
+}
+
+// Checks that a query found exactly the expected points, in any order
+std::string CompareIndices(const std::string& what, std::vector<PointIndex> found,
+                           std::vector<PointIndex> expected) {
+  std::sort(found.begin(), found.end());
+  std::sort(expected.begin(), expected.end());
+  if (found.size() != expected.size()) {
+    return Mismatch("Points found by " + what, found.size(), expected.size());
+  }
+  for (size_t i = 0; i < found.size(); ++i) {
+    if (found[i] != expected[i]) {
+      return Mismatch("Point " + std::to_string(i) + " found by " + what, found[i], expected[i]);
+    }
+  }
+  return "";
+}
+
+/**
+ * @brief Compares the nearest, k nearest and radius queries of a spatial
+ * index, batched ones included, with a scan of every point. Queries are random
+ * points and some of the indexed points themselves. Neighbors are compared by
+ * distance, since ties may go to any of the points at that distance.
+ */
+template <typename Index>
+std::string CheckNeighborQueries(std::mt19937_64& rng, Distribution distribution) {
+  using PointT = typename Index::PointVector::value_type;
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  std::vector<PointT> queries = RandomPoints<PointT>(rng, distribution);
+  queries.insert(queries.end(), points.begin(), points.begin() + points.size() / 4);
+  std::uniform_int_distribution<size_t> pick_k(1, 12);
+  std::uniform_int_distribution<int> lattice_radius(0, 4);
+  std::uniform_real_distribution<double> radius_length(0, 3000);
+  const size_t k = pick_k(rng);
+  // Lattice radii are whole, so points lie exactly on the circle
+  const double radius = distribution == LATTICE ? lattice_radius(rng) : radius_length(rng);
+
+  const Index index(points);
+  const std::vector<PointIndex> nearest = index.Nearest(queries);
+  const std::vector<PointIndex> k_nearest = index.KNearest(queries, k);
+  const size_t found = std::min(k, points.size());
+  std::vector<Neighbor> neighbors;
+  std::vector<PointIndex> in_radius;
+  for (size_t q = 0; q < queries.size(); ++q) {
+    const PointT& query = queries[q];
+    std::vector<double> distances;
+    std::vector<PointIndex> expected_in_radius;
+    for (PointIndex i = 0; i < points.size(); ++i) {
+      distances.push_back(SquaredDistance(query, points[i]));
+      if (distances.back() <= radius * radius) {
+        expected_in_radius.push_back(i);
+      }
+    }
+    std::vector<double> sorted = distances;
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::string where = " of query " + std::to_string(q);
+    if (distances[index.Nearest(query)] != sorted[0]) {
+      return Mismatch("Nearest distance" + where, distances[index.Nearest(query)], sorted[0]);
+    }
+    if (distances[nearest[q]] != sorted[0]) {
+      return Mismatch("Batched nearest distance" + where, distances[nearest[q]], sorted[0]);
+    }
+
+    index.KNearest(query, k, neighbors);
+    if (neighbors.size() != found) {
+      return Mismatch("Neighbor count" + where, neighbors.size(), found);
+    }
+    std::vector<PointIndex> neighbor_indices;
+    for (size_t t = 0; t < found; ++t) {
+      const std::string neighbor = " to neighbor " + std::to_string(t) + where;
+      const Neighbor& reported = neighbors[t];
+      if (reported.first != sorted[t] || distances[reported.second] != sorted[t]) {
+        return Mismatch("Squared distance" + neighbor, distances[reported.second], sorted[t]);
+      }
+      if (distances[k_nearest[q * found + t]] != sorted[t]) {
+        return Mismatch("Batched squared distance" + neighbor,
+                        distances[k_nearest[q * found + t]], sorted[t]);
+      }
+      neighbor_indices.push_back(reported.second);
+    }
+    std::sort(neighbor_indices.begin(), neighbor_indices.end());
+    if (std::adjacent_find(neighbor_indices.begin(), neighbor_indices.end()) !=
+        neighbor_indices.end()) {
+      return "A point is repeated among the neighbors" + where;
+    }
+
+    index.Radius(query, radius, in_radius);
+    if (std::string failure = CompareIndices("the radius query" + where, in_radius,
+                                             expected_in_radius);
+        !failure.empty()) {
+      return failure;
+    }
+  }
+  return "";
+}
+
+/**
+ * @brief Compares the rectangle and batched radius queries of the k-d tree
+ * with a scan of every point. Both take the points on their border.
+ *
+ */
+template <typename PointT>
+std::string CheckKdTreeRegions(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  const std::vector<PointT> corners = RandomPoints<PointT>(rng, distribution);
+  std::uniform_int_distribution<int> lattice_radius(0, 4);
+  std::uniform_real_distribution<double> radius_length(0, 3000);
+  const double radius = distribution == LATTICE ? lattice_radius(rng) : radius_length(rng);
+  const BasicKdTree<PointT> tree(points);
+
+  std::vector<PointIndex> found;
+  for (size_t c = 0; c + 1 < corners.size(); c += 2) {
+    const PointT low{std::min(corners[c].x, corners[c + 1].x),
+                     std::min(corners[c].y, corners[c + 1].y)};
+    const PointT high{std::max(corners[c].x, corners[c + 1].x),
+                      std::max(corners[c].y, corners[c + 1].y)};
+    std::vector<PointIndex> expected;
+    for (PointIndex i = 0; i < points.size(); ++i) {
+      if (points[i].x >= low.x && points[i].x <= high.x && points[i].y >= low.y &&
+          points[i].y <= high.y) {
+        expected.push_back(i);
+      }
+    }
+    tree.Rectangle(low, high, found);
+    if (std::string failure =
+            CompareIndices("rectangle " + std::to_string(c / 2), found, expected);
+        !failure.empty()) {
+      return failure;
+    }
+  }
+
+  std::vector<size_t> offsets;
+  tree.Radius(corners, radius, offsets, found);
+  for (size_t q = 0; q < corners.size(); ++q) {
+    std::vector<PointIndex> expected;
+    for (PointIndex i = 0; i < points.size(); ++i) {
+      if (SquaredDistance(corners[q], points[i]) <= radius * radius) {
+        expected.push_back(i);
+      }
+    }
+    const std::vector<PointIndex> batch(found.begin() + offsets[q], found.begin() + offsets[q + 1]);
+    if (std::string failure =
+            CompareIndices("the batched radius query " + std::to_string(q), batch, expected);
+        !failure.empty()) {
+      return failure;
+    }
+  }
+  return "";
+}
+
+// Scratch file of the checks that go through the file system
+std::string ScratchFile(const std::string& extension) {
+  const std::string name = "cya_check_" + std::to_string(::getpid()) + extension;
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * @brief Writes the points in one binary layout and coordinate type and
+ * parses them back as PointT, which must give the points rounded to the
+ * coordinate type. INT32 must refuse fractional coordinates instead.
+ *
+ */
+template <typename PointT>
+std::string CheckRoundTrip(const std::vector<Point>& points, Layout layout, CoordinateType type,
+                           const std::string& filename) {
+  using Coordinate = CoordinateOf<PointT>;
+  const bool integral = std::all_of(points.begin(), points.end(), [](const Point& point) {
+    return std::trunc(point.x) == point.x && std::trunc(point.y) == point.y;
+  });
+  try {
+    WriteBinaryPoints(filename, points, layout, type);
+  } catch (const std::runtime_error& e) {
+    return type == INT32 && !integral ? "" : std::string("Unable to write: ") + e.what();
+  }
+  if (type == INT32 && !integral) {
+    return "INT32 took fractional coordinates";
+  }
+
+  const auto parsed = ParsePointsFromFile<PointT>(filename);
+  if (!parsed || parsed->size() != points.size()) {
+    return "Unable to read the points back";
+  }
+  // What the file stores, as the parser converts it
+  auto stored = [type](double value) {
+    return static_cast<Coordinate>(type == FLOAT32 ? double(float(value)) : value);
+  };
+  const std::string where = " of type " + std::to_string(type) + " and layout " +
+                            std::to_string(layout);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const PointT& point = (*parsed)[i];
+    if (point.x != stored(points[i].x)) {
+      return Mismatch("x of point " + std::to_string(i) + where, point.x, stored(points[i].x));
+    }
+    if (point.y != stored(points[i].y)) {
+      return Mismatch("y of point " + std::to_string(i) + where, point.y, stored(points[i].y));
+    }
+  }
+  return "";
+}
+
+template <typename PointT>
+std::string CheckBinaryRoundTrip(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<Point> points = RandomPoints<Point>(rng, distribution);
+  const std::string filename = ScratchFile(".cyap");
+  std::string failure;
+  for (const Layout layout : {AOS, SOA}) {
+    for (const CoordinateType type : {FLOAT64, FLOAT32, INT32}) {
+      if (failure.empty()) {
+        failure = CheckRoundTrip<PointT>(points, layout, type, filename);
+      }
+    }
+  }
+  std::filesystem::remove(filename);
+  return failure;
+}
+
+/**
+ * @brief Reads the points through PointStream over a file stream, as stdin
+ * and files that cannot be mapped are read, once as text and once in each
+ * binary layout. Every input must yield the points themselves.
+ *
+ */
+template <typename PointT>
+std::string CheckPointStream(std::mt19937_64& rng, Distribution distribution) {
+  const std::vector<PointT> points = RandomPoints<PointT>(rng, distribution);
+  std::vector<Point> wide;
+  for (const PointT& point : points) {
+    wide.push_back({static_cast<double>(point.x), static_cast<double>(point.y)});
+  }
+  const std::string text_file = ScratchFile(".txt");
+  const std::string binary_file = ScratchFile(".cyap");
+  {
+    std::ofstream text(text_file);
+    text.precision(17);
+    text << points.size() << '\n';
+    for (const Point& point : wide) {
+      text << point.x << ' ' << point.y << '\n';
+    }
+  }
+
+  auto compare = [&points](const std::string& filename, const std::string& what) {
+    std::ifstream input(filename, std::ios::binary);
+    auto stream = PointParser<PointT>::StreamFromStream(input);
+    std::vector<PointT> streamed;
+    for (const PointT& point : stream) {
+      streamed.push_back(point);
+    }
+    if (stream.GetError()) {
+      return what + ": " + stream.GetError()->what();
+    }
+    if (streamed.size() != points.size()) {
+      return Mismatch("Points streamed from " + what, streamed.size(), points.size());
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+      const std::string where = " of point " + std::to_string(i) + " streamed from " + what;
+      if (streamed[i].x != points[i].x) {
+        return Mismatch("x" + where, streamed[i].x, points[i].x);
+      }
+      if (streamed[i].y != points[i].y) {
+        return Mismatch("y" + where, streamed[i].y, points[i].y);
+      }
+    }
+    return std::string();
+  };
+  std::string failure = compare(text_file, "text");
+  for (const Layout layout : {AOS, SOA}) {
+    if (failure.empty()) {
+      WriteBinaryPoints(binary_file, wide, layout);
+      failure = compare(binary_file, "binary layout " + std::to_string(layout));
+    }
+  }
+  std::filesystem::remove(text_file);
+  std::filesystem::remove(binary_file);
+  return failure;
+}
+
+/**
+ * @brief Parses a text of several MiB, large enough to be split into parallel
+ * chunks and read from a stream in several blocks, and compares the result
+ * with the points written. Lines are padded with blanks, CRLF endings and
+ * empty lines, so chunk and block bounds fall on all of them. A copy with one
+ * broken line must fail on that line, counted from the start of the text.
+ *
+ * The buffer and stream parsers are chunked; PointStream parses line by line.
+ */
+template <typename PointT>
+std::string CheckChunkedParsing(std::mt19937_64& rng, Distribution distribution) {
+  std::vector<PointT> points;
+  std::string body;                 // The text after the amount of points
+  std::vector<size_t> line_ends;    // Offset in `body` of the newline of each point
+  std::vector<size_t> point_lines;  // Line number of each point in the text
+  size_t lines = 2;                 // An empty line and the amount come first
+  std::uniform_int_distribution<size_t> pick(0, 7);
+  const std::string_view blanks[] = {"", " ", "\t", " \t "};
+  auto append = [&body](auto coordinate) {
+    char digits[32];
+    body.append(digits, std::to_chars(digits, digits + sizeof(digits), coordinate).ptr);
+  };
+  while (body.size() < kChunkedCheckBytes) {
+    for (const PointT& point : RandomPoints<PointT>(rng, distribution)) {
+      if (pick(rng) == 0) {
+        body += blanks[pick(rng) % 4];
+        body += '\n';
+        ++lines;
+      }
+      body += blanks[pick(rng) % 2];
+      append(point.x);
+      body += blanks[pick(rng) % 3 + 1];
+      append(point.y);
+      body += blanks[pick(rng) % 2];
+      body += pick(rng) < 2 ? "\r" : "";
+      line_ends.push_back(body.size());
+      point_lines.push_back(++lines);
+      body += '\n';
+      points.push_back(point);
+    }
+  }
+  const std::string header = "\n" + std::to_string(points.size()) + "\n";
+
+  auto parse_all = [](const std::string& text) {
+    std::vector<std::expected<std::vector<PointT>, ParseError>> results;
+    results.push_back(PointParser<PointT>::ParseFromBuffer(text));
+    std::istringstream input(text);
+    results.push_back(PointParser<PointT>::ParseFromStream(input));
+    auto stream = PointParser<PointT>::StreamFromBuffer(text);
+    std::vector<PointT> streamed;
+    for (const PointT& point : stream) {
+      streamed.push_back(point);
+    }
+    if (stream.GetError()) {
+      results.push_back(std::unexpected(*stream.GetError()));
+    } else {
+      results.push_back(std::move(streamed));
+    }
+    return results;
+  };
+  const std::string parsers[] = {"the buffer parser", "the stream parser", "PointStream"};
+
+  const auto results = parse_all(header + body);
+  for (size_t parser = 0; parser < results.size(); ++parser) {
+    const auto& parsed = results[parser];
+    if (!parsed) {
+      return parsers[parser] + ": " + parsed.error().what();
+    }
+    if (parsed->size() != points.size()) {
+      return Mismatch("Points parsed by " + parsers[parser], parsed->size(), points.size());
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+      const std::string where = " of point " + std::to_string(i) + " by " + parsers[parser];
+      if ((*parsed)[i].x != points[i].x) {
+        return Mismatch("x" + where, (*parsed)[i].x, points[i].x);
+      }
+      if ((*parsed)[i].y != points[i].y) {
+        return Mismatch("y" + where, (*parsed)[i].y, points[i].y);
+      }
+    }
+  }
+
+  std::uniform_int_distribution<size_t> pick_broken(0, points.size() - 1);
+  const size_t broken = pick_broken(rng);
+  const size_t broken_line = point_lines[broken];
+  body.insert(line_ends[broken], " 1");
+  const auto failures = parse_all(header + body);
+  for (size_t parser = 0; parser < failures.size(); ++parser) {
+    const auto& parsed = failures[parser];
+    if (parsed) {
+      return parsers[parser] + " took a line with three coordinates";
+    }
+    if (parsed.error().GetLine() != int(broken_line)) {
+      return Mismatch("Error line of " + parsers[parser], parsed.error().GetLine(), broken_line);
+    }
+  }
+  return "";
+}
+
+std::vector<Check> Checks() {
+  return {
+      {"NearestInOctants, uniform", [](auto& rng) { return CheckOctants<Point>(rng, UNIFORM); }},
+      {"NearestInOctants int32, lattice",
+       [](auto& rng) { return CheckOctants<PointI>(rng, LATTICE); }},
+      {"KdTree queries, uniform",
+       [](auto& rng) { return CheckNeighborQueries<KdTree>(rng, UNIFORM); }},
+      {"KdTree queries float32, clusters",
+       [](auto& rng) { return CheckNeighborQueries<BasicKdTree<PointF>>(rng, CLUSTERED); }},
+      {"KdTree queries int32, lattice",
+       [](auto& rng) { return CheckNeighborQueries<BasicKdTree<PointI>>(rng, LATTICE); }},
+      {"KdTree regions, uniform",
+       [](auto& rng) { return CheckKdTreeRegions<Point>(rng, UNIFORM); }},
+      {"KdTree regions int32, lattice",
+       [](auto& rng) { return CheckKdTreeRegions<PointI>(rng, LATTICE); }},
+      {"UniformGrid queries, uniform",
+       [](auto& rng) { return CheckNeighborQueries<UniformGrid>(rng, UNIFORM); }},
+      {"UniformGrid queries, clusters",
+       [](auto& rng) { return CheckNeighborQueries<UniformGrid>(rng, CLUSTERED); }},
+      {"UniformGrid queries float32, clusters",
+       [](auto& rng) { return CheckNeighborQueries<BasicUniformGrid<PointF>>(rng, CLUSTERED); }},
+      {"UniformGrid queries int32, lattice",
+       [](auto& rng) { return CheckNeighborQueries<BasicUniformGrid<PointI>>(rng, LATTICE); }},
+      {"EMSTSparse, uniform", [](auto& rng) { return CheckSparseEMST<Point>(rng, UNIFORM); }},
+      {"EMSTSparse, clusters",
+       [](auto& rng) { return CheckSparseEMST<Point>(rng, CLUSTERED); }},
+      {"EMSTSparse float32, clusters",
+       [](auto& rng) { return CheckSparseEMST<PointF>(rng, CLUSTERED); }},
+      {"EMSTSparse int32, lattice",
+       [](auto& rng) { return CheckSparseEMST<PointI>(rng, LATTICE); }},
+      {"AddPoints, uniform", [](auto& rng) { return CheckAddPoints<Point>(rng, UNIFORM); }},
+      {"AddPoints, clusters", [](auto& rng) { return CheckAddPoints<Point>(rng, CLUSTERED); }},
+      {"AddPoints float32, clusters",
+       [](auto& rng) { return CheckAddPoints<PointF>(rng, CLUSTERED); }},
+      {"AddPoints int32, lattice",
+       [](auto& rng) { return CheckAddPoints<PointI>(rng, LATTICE); }},
+      {"Binary round trip, uniform",
+       [](auto& rng) { return CheckBinaryRoundTrip<Point>(rng, UNIFORM); }},
+      {"Binary round trip float32, uniform",
+       [](auto& rng) { return CheckBinaryRoundTrip<PointF>(rng, UNIFORM); }},
+      {"Binary round trip int32, lattice",
+       [](auto& rng) { return CheckBinaryRoundTrip<PointI>(rng, LATTICE); }},
+      {"PointStream from a stream, uniform",
+       [](auto& rng) { return CheckPointStream<Point>(rng, UNIFORM); }},
+      {"PointStream int32 from a stream, lattice",
+       [](auto& rng) { return CheckPointStream<PointI>(rng, LATTICE); }},
+      {"Chunked parsing, uniform",
+       [](auto& rng) { return CheckChunkedParsing<Point>(rng, UNIFORM); }},
+      {"Chunked parsing int32, lattice",
+       [](auto& rng) { return CheckChunkedParsing<PointI>(rng, LATTICE); }},
+  };
+}
+
+}  // namespace
+
+CheckSummary RunSelfChecks(const CheckOptions& options, std::ostream& report) {
+  CheckSummary summary;
+  for (const Check& check : Checks()) {
+    std::mt19937_64 rng(options.seed);
+    std::string failure;
+    size_t trial = 0;
+    for (; trial < options.trials && failure.empty(); ++trial) {
+      failure = check.trial(rng);
+    }
+    if (failure.empty()) {
+      ++summary.passed;
+      report << "PASS " << check.name << std::endl;
+    } else {
+      ++summary.failed;
+      report << "FAIL " << check.name << ", trial " << trial << ": " << failure << std::endl;
+    }
+  }
+  return summary;
+}
+
+}  // namespace cya
@@ -0,0 +1,517 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo server.cc: Implementación del servicio sobre un socket Unix
+ * Referencias:
+ */
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "cya/binary_format.h"
+#include "cya/buffered_writer.h"
+#include "cya/pointset.h"
+#include "cya/server.h"
+
+namespace cya {
+
+namespace {
+
+// Seconds a socket client may stall in the middle of a frame or a response
+constexpr int kStallSeconds = 30;
+
+struct FrameHeader {
+  std::uint8_t code = 0;
+  std::uint64_t length = 0;
+};
+
+/**
+ * @brief Reads exactly `size` bytes.
+ *
+ * @return false if the connection was closed before the first byte.
+ */
+bool ReadExactly(int descriptor, char* data, size_t size) {
+  size_t done = 0;
+  while (done < size) {
+    const ssize_t count = ::read(descriptor, data + done, size - done);
+    if (count == -1 && errno == EINTR) {
+      continue;
+    }
+    if (count == -1) {
+      throw std::runtime_error(std::string("Connection error: ") + std::strerror(errno));
+    }
+    if (count == 0) {
+      if (done == 0) {
+        return false;
+      }
+      throw std::runtime_error("Connection closed in the middle of a frame");
+    }
+    done += count;
+  }
+  return true;
+}
+
+void WriteExactly(int descriptor, std::string_view data) {
+  while (!data.empty()) {
+    const ssize_t count = ::write(descriptor, data.data(), data.size());
+    if (count == -1 && errno == EINTR) {
+      continue;
+    }
+    if (count == -1) {
+      throw std::runtime_error(std::string("Connection error: ") + std::strerror(errno));
+    }
+    data.remove_prefix(count);
+  }
+}
+
+template <typename T>
+void AppendLittleEndian(std::string& out, T value) {
+  const auto bits = LittleEndian(value);
+  out.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+}
+
+using FrameBytes = std::array<char, kBinaryHeaderSize>;
+
+FrameBytes EncodeFrameHeader(const char (&magic)[4], std::uint8_t code, std::uint64_t length) {
+  FrameBytes bytes{};
+  const std::uint16_t version = LittleEndian(kBinaryVersion);
+  length = LittleEndian(length);
+  std::memcpy(bytes.data(), magic, sizeof(magic));
+  std::memcpy(bytes.data() + 4, &version, sizeof(version));
+  bytes[6] = static_cast<char>(code);
+  std::memcpy(bytes.data() + 8, &length, sizeof(length));
+  return bytes;
+}
+
+void WriteFrameHeader(BufferedWriter& writer, std::uint8_t code, std::uint64_t length) {
+  const FrameBytes bytes = EncodeFrameHeader(kResponseMagic, code, length);
+  writer << std::string_view(bytes.data(), bytes.size());
+}
+
+void WriteError(BufferedWriter& writer, std::string_view message) {
+  WriteFrameHeader(writer, RESPONSE_ERROR, message.size());
+  writer << message;
+}
+
+/**
+ * @brief Reads the header of the next frame, whose payload may be at most
+ * `max_length` bytes.
+ *
+ * @return Nothing if the connection was closed between frames.
+ */
+std::optional<FrameHeader> ReadFrameHeader(int descriptor, const char (&magic)[4],
+                                           size_t max_length) {
+  char bytes[kBinaryHeaderSize];
+  if (!ReadExactly(descriptor, bytes, sizeof(bytes))) {
+    return std::nullopt;
+  }
+  std::uint16_t version;
+  std::memcpy(&version, bytes + 4, sizeof(version));
+  if (std::memcmp(bytes, magic, sizeof(magic)) != 0 || LittleEndian(version) != kBinaryVersion) {
+    throw std::runtime_error("Invalid frame header");
+  }
+  FrameHeader header;
+  header.code = static_cast<std::uint8_t>(bytes[6]);
+  std::memcpy(&header.length, bytes + 8, sizeof(header.length));
+  header.length = LittleEndian(header.length);
+  if (header.length > max_length) {
+    throw std::runtime_error("Frame too large: " + std::to_string(header.length) +
+                             " bytes, the limit is " + std::to_string(max_length));
+  }
+  return header;
+}
+
+/**
+ * @brief Decodes the points of a binary point payload.
+ *
+ */
+template <typename PointT>
+void DecodePoints(std::string_view payload, const BinaryHeader& header,
+                  std::vector<PointT>& points) {
+  using Coordinate = CoordinateOf<PointT>;
+  const size_t count = header.count;
+  const char* data = payload.data() + kBinaryHeaderSize;
+  points.resize(count);
+  if (std::endian::native == std::endian::little && header.layout == AOS &&
+      header.coordinate_type == kNativeCoordinateType<Coordinate>) {
+    std::memcpy(points.data(), data, count * sizeof(PointT));
+    return;
+  }
+  const CoordinateType type = header.coordinate_type;
+  const size_t size = CoordinateSize(type);
+  const size_t stride = header.layout == AOS ? 2 * size : size;
+  const size_t y_offset = header.layout == AOS ? size : count * size;
+  for (size_t i = 0; i < count; ++i) {
+    points[i].x = static_cast<Coordinate>(ReadCoordinate(data + i * stride, type));
+    points[i].y = static_cast<Coordinate>(ReadCoordinate(data + y_offset + i * stride, type));
+  }
+}
+
+// Solves a request over points of type PointT and writes the response
+template <typename PointT>
+void Answer(RequestKind kind, std::string_view payload, const BinaryHeader& header,
+            BufferedWriter& writer) {
+  std::vector<PointT> points;
+  DecodePoints(payload, header, points);
+  BasicPointSet<PointT> point_set(std::move(points));
+  if (kind == HULL_REQUEST) {
+    point_set.QuickHullImproved();
+    const std::vector<PointIndex> hull = point_set.GetHullIndices();
+    WriteFrameHeader(writer, RESPONSE_OK, BinaryIndicesSize(HULL_INDICES, hull.size()));
+    WriteHullIndices(writer, hull);
+  } else {
+    point_set.EMSTSparse();
+    const IndexTree& tree = point_set.GetIndexTree();
+    WriteFrameHeader(writer, RESPONSE_OK, BinaryIndicesSize(TREE_INDICES, tree.size()));
+    WriteTreeIndices(writer, tree);
+  }
+}
+
+void Answer(std::uint8_t kind, std::string_view payload, BufferedWriter& writer) {
+  if (kind > EMST_REQUEST) {
+    throw std::runtime_error("Unknown request kind: " + std::to_string(kind));
+  }
+  const std::optional<BinaryHeader> header = ReadBinaryHeader(payload);
+  if (!header) {
+    throw std::runtime_error("Invalid binary point payload");
+  }
+  const auto request = static_cast<RequestKind>(kind);
+  switch (header->coordinate_type) {
+    case FLOAT32:
+      Answer<PointF>(request, payload, *header, writer);
+      break;
+    case INT32:
+      Answer<PointI>(request, payload, *header, writer);
+      break;
+    default:
+      Answer<Point>(request, payload, *header, writer);
+  }
+}
+
+int ConnectSocket(const std::string& path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Socket path too long: " + path);
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  const int descriptor = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (descriptor == -1 ||
+      ::connect(descriptor, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+    const std::string reason = std::strerror(errno);
+    if (descriptor != -1) {
+      ::close(descriptor);
+    }
+    throw std::runtime_error("Unable to connect to " + path + ": " + reason);
+  }
+  return descriptor;
+}
+
+// Request frame with the points in the binary AoS double format
+std::string EncodeRequest(RequestKind kind, std::span<const Point> points) {
+  const std::uint64_t length = kBinaryHeaderSize + points.size() * sizeof(Point);
+  const FrameBytes header = EncodeFrameHeader(kRequestMagic, kind, length);
+  std::string request(header.data(), header.size());
+  request.reserve(kBinaryHeaderSize + length);
+  request.append(kBinaryMagic, sizeof(kBinaryMagic));
+  AppendLittleEndian(request, kBinaryVersion);
+  request += static_cast<char>(FLOAT64);
+  request += static_cast<char>(AOS);
+  AppendLittleEndian(request, static_cast<std::uint64_t>(points.size()));
+  for (const Point& point : points) {
+    AppendLittleEndian(request, std::bit_cast<std::uint64_t>(point.x));
+    AppendLittleEndian(request, std::bit_cast<std::uint64_t>(point.y));
+  }
+  return request;
+}
+
+}  // namespace
+
+ScratchArena::ScratchArena(size_t bytes) : block_(bytes) {
+  resource_.emplace(block_.data(), block_.size(), &upstream_);
+}
+
+void ScratchArena::Reset() {
+  resource_.reset();
+  if (upstream_.allocated > 0) {
+    block_.resize(block_.size() + upstream_.allocated);
+    upstream_.allocated = 0;
+  }
+  resource_.emplace(block_.data(), block_.size(), &upstream_);
+}
+
+void* ScratchArena::CountingResource::do_allocate(size_t bytes, size_t alignment) {
+  allocated += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void ScratchArena::CountingResource::do_deallocate(void* pointer, size_t bytes,
+                                                   size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool ScratchArena::CountingResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void Server::ServeSocket(const std::string& path) {
+  // A client that goes away must not take the server down with it
+  std::signal(SIGPIPE, SIG_IGN);
+
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Socket path too long: " + path);
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  // Only a socket left behind by an earlier server is replaced
+  struct stat status;
+  if (::stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+    ::unlink(path.c_str());
+  }
+  const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener == -1 ||
+      ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 ||
+      ::listen(listener, SOMAXCONN) == -1) {
+    const std::string reason = std::strerror(errno);
+    if (listener != -1) {
+      ::close(listener);
+    }
+    throw std::runtime_error("Unable to listen on " + path + ": " + reason);
+  }
+
+  if (::pipe(wake_) == -1) {
+    ::close(listener);
+    throw std::runtime_error(std::string("Unable to create a pipe: ") + std::strerror(errno));
+  }
+
+  // The listener and the wake pipe come first, then the idle connections. A
+  // connection leaves the set while a worker answers its request.
+  std::vector<pollfd> watched{{listener, POLLIN, 0}, {wake_[0], POLLIN, 0}};
+  const timeval stall{kStallSeconds, 0};
+  while (true) {
+    if (::poll(watched.data(), watched.size(), -1) == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ::close(listener);
+      throw std::runtime_error(std::string("Unable to wait for requests: ") +
+                               std::strerror(errno));
+    }
+
+    for (size_t i = 2; i < watched.size();) {
+      if (watched[i].revents == 0) {
+        ++i;
+        continue;
+      }
+      const int connection = watched[i].fd;
+      watched[i] = watched.back();
+      watched.pop_back();
+      pool_.Submit([this, connection]() {
+        bool open = false;
+        try {
+          BufferedWriter writer(connection);
+          open = ServeRequest(connection, writer, max_payload_);
+        } catch (const std::exception& e) {
+          std::cerr << "Error: " << e.what() << std::endl;
+        }
+        if (open) {
+          Resume(connection);
+        } else {
+          ::close(connection);
+        }
+      });
+    }
+
+    if (watched[1].revents != 0) {
+      char drained[64];
+      while (::read(wake_[0], drained, sizeof(drained)) == -1 && errno == EINTR) {
+      }
+      std::lock_guard lock(mutex_);
+      for (const int connection : resumed_) {
+        watched.push_back({connection, POLLIN, 0});
+      }
+      resumed_.clear();
+    }
+
+    if (watched[0].revents != 0) {
+      const int connection = ::accept(listener, nullptr, nullptr);
+      if (connection == -1) {
+        if (errno == EINTR || errno == ECONNABORTED) {
+          continue;
+        }
+        ::close(listener);
+        throw std::runtime_error(std::string("Unable to accept connections: ") +
+                                 std::strerror(errno));
+      }
+      // A stalled client fails its read or write instead of holding a worker
+      ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &stall, sizeof(stall));
+      ::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &stall, sizeof(stall));
+      watched.push_back({connection, POLLIN, 0});
+    }
+  }
+}
+
+Server::~Server() {
+  pool_.Wait();
+  for (const int end : wake_) {
+    if (end != -1) {
+      ::close(end);
+    }
+  }
+}
+
+void Server::Resume(int connection) {
+  {
+    std::lock_guard lock(mutex_);
+    resumed_.push_back(connection);
+  }
+  const char byte = 0;
+  while (::write(wake_[1], &byte, 1) == -1 && errno == EINTR) {
+  }
+}
+
+/**
+ * @brief Answers requests until the client closes the connection.
+ *
+ */
+void Server::ServeConnection(int input, int output, size_t max_payload) {
+  BufferedWriter writer(output);
+  while (ServeRequest(input, writer, max_payload)) {
+  }
+  writer.Close();
+}
+
+/**
+ * @brief Reads one request frame, answers it and flushes the response.
+ *
+ * A request that cannot be solved gets an error response and the connection
+ * goes on; a malformed frame throws, since the next frame cannot be found.
+ */
+bool Server::ServeRequest(int input, BufferedWriter& writer, size_t max_payload) {
+  thread_local ScratchArena arena;
+  std::optional<FrameHeader> header;
+  try {
+    header = ReadFrameHeader(input, kRequestMagic, max_payload);
+  } catch (const std::exception& e) {
+    WriteError(writer, e.what());
+    writer.Flush();
+    throw;
+  }
+  if (!header) {
+    return false;
+  }
+
+  arena.Reset();
+  std::pmr::vector<char> payload(header->length, arena.GetResource());
+  if (!ReadExactly(input, payload.data(), payload.size())) {
+    throw std::runtime_error("Connection closed in the middle of a frame");
+  }
+  try {
+    Answer(header->code, std::string_view(payload.data(), payload.size()), writer);
+  } catch (const std::exception& e) {
+    WriteError(writer, e.what());
+  }
+  writer.Flush();
+  return true;
+}
+
+double LoadSummary::Percentile(double fraction) const {
+  if (latencies.empty()) {
+    return 0.0;
+  }
+  const auto rank = static_cast<size_t>(fraction * latencies.size());
+  return latencies[std::min(rank, latencies.size() - 1)];
+}
+
+LoadSummary RunLoad(const std::string& path, std::span<const Point> points, RequestKind kind,
+                    size_t requests, size_t connections) {
+  const std::string request = EncodeRequest(kind, points);
+  // Responses hold at most two indices per point, less than the request
+  const size_t max_response = std::max(kDefaultMaxPayload, request.size());
+  connections = std::clamp<size_t>(connections, 1, std::max<size_t>(requests, 1));
+  std::vector<std::vector<double>> latencies(connections);
+  std::atomic<size_t> failed = 0;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> clients;
+  for (size_t c = 0; c < connections; ++c) {
+    clients.emplace_back([&, c]() {
+      try {
+        const int descriptor = ConnectSocket(path);
+        std::vector<char> response;
+        const size_t share = requests * (c + 1) / connections - requests * c / connections;
+        for (size_t r = 0; r < share; ++r) {
+          const auto sent = std::chrono::steady_clock::now();
+          WriteExactly(descriptor, request);
+          const std::optional<FrameHeader> header =
+              ReadFrameHeader(descriptor, kResponseMagic, max_response);
+          if (!header) {
+            throw std::runtime_error("The server closed the connection");
+          }
+          response.resize(header->length);
+          if (!ReadExactly(descriptor, response.data(), response.size())) {
+            throw std::runtime_error("The server closed the connection");
+          }
+          latencies[c].push_back(
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - sent).count());
+          if (header->code != RESPONSE_OK) {
+            ++failed;
+          }
+        }
+        ::close(descriptor);
+      } catch (...) {
+        std::lock_guard lock(error_mutex);
+        error = std::current_exception();
+      }
+    });
+  }
+  for (std::thread& client : clients) {
+    client.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  LoadSummary summary;
+  summary.seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  for (const std::vector<double>& connection : latencies) {
+    summary.latencies.insert(summary.latencies.end(), connection.begin(), connection.end());
+  }
+  std::sort(summary.latencies.begin(), summary.latencies.end());
+  summary.requests = summary.latencies.size();
+  summary.failed = failed;
+  return summary;
+}
+
+}  // namespace cya
@@ -0,0 +1,110 @@
+/**
+ * Universidad de La Laguna
+ * Escuela Superior de Ingeniería y Tecnología
+ * Grado en Ingenierıa Informática
+ * Asignatura: Computabilidad y Algoritmia
+ * Curso: 4º
+ * Práctica 12: Divide y Vencerás
+ * Grado en Ingeniería Informática
+ * Computabilidad y Algoritmia
+ * Autor: Pablo Hernández Jiménez
+ * Correo: alu0101495934@ull.edu.es
+ * Fecha: 19/10/2026
+ * Archivo space_filling.cc: Implementación de las curvas de Morton y Hilbert
+ * Referencias: https://en.wikipedia.org/wiki/Hilbert_curve
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "cya/parallel.h"
+#include "cya/space_filling.h"
+
+namespace cya {
+
+namespace {
+
+// Spreads the 32 bits of `value` over the even bits of the result
+std::uint64_t SpreadBits(std::uint32_t value) {
+  std::uint64_t bits = value;
+  bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+  bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+  bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+  bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+  bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+  return bits;
+}
+
+}  // namespace
+
+std::uint64_t MortonKey(std::uint32_t x, std::uint32_t y) {
+  return SpreadBits(x) | (SpreadBits(y) << 1);
+}
+
+std::uint64_t HilbertKey(std::uint32_t x, std::uint32_t y) {
+  std::uint64_t key = 0;
+  for (std::uint32_t s = std::uint32_t{1} << 31; s > 0; s >>= 1) {
+    const std::uint32_t rx = (x & s) ? 1 : 0;
+    const std::uint32_t ry = (y & s) ? 1 : 0;
+    key += std::uint64_t{s} * s * ((3 * rx) ^ ry);
+    // Rotate the quadrant so the curve stays continuous
+    if (ry == 0) {
+      if (rx == 1) {
+        x = ~x;
+        y = ~y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return key;
+}
+
+Curve ParseCurve(const std::string& name) {
+  if (name == "morton") {
+    return MORTON;
+  }
+  if (name == "hilbert") {
+    return HILBERT;
+  }
+  throw std::runtime_error("Unknown space-filling curve: " + name);
+}
+
+template <typename PointT>
+std::vector<RadixRecord> CurveKeys(std::span<const PointT> points, Curve curve) {
+  std::vector<RadixRecord> records(points.size());
+  if (points.empty()) {
+    return records;
+  }
+
+  PointT min = points[0];
+  PointT max = points[0];
+  for (const PointT& point : points) {
+    min = {std::min(min.x, point.x), std::min(min.y, point.y)};
+    max = {std::max(max.x, point.x), std::max(max.y, point.y)};
+  }
+  const double extent = std::max(static_cast<double>(max.x) - min.x,
+                                 static_cast<double>(max.y) - min.y);
+  const double top = std::numeric_limits<std::uint32_t>::max();
+  const double scale = extent > 0 ? top / extent : 0.0;
+  auto quantize = [&](double offset) {
+    return static_cast<std::uint32_t>(std::min(offset * scale, top));
+  };
+
+  const size_t n = points.size();
+  ParallelChunks(n, ParallelChunkCount(n), [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const std::uint32_t x = quantize(static_cast<double>(points[i].x) - min.x);
+      const std::uint32_t y = quantize(static_cast<double>(points[i].y) - min.y);
+      records[i] = {curve == HILBERT ? HilbertKey(x, y) : MortonKey(x, y), PointIndex(i)};
+    }
+  });
+  return records;
+}
+
+template std::vector<RadixRecord> CurveKeys(std::span<const Point> points, Curve curve);
+template std::vector<RadixRecord> CurveKeys(std::span<const PointF> points, Curve curve);
+template std::vector<RadixRecord> CurveKeys(std::span<const PointI> points, Curve curve);
+
+}  // namespace cya